@@ -0,0 +1,262 @@
+/**
+* @file boykovkolmogorov.cpp
+* @brief This file contains the Boykov-Kolmogorov max-flow engine implementation.
+ */
+
+// Project headers
+#include "boykovkolmogorov.h"
+// Standard Library Headers
+#include <algorithm>
+#include <climits>
+
+#define FREE 0
+#define SOURCE_TREE 1
+#define SINK_TREE 2
+
+#define TERMINAL (-1)
+#define ORPHAN (-2)
+#define NO_PARENT (-3)
+
+void BoykovKolmogorov::build(Graph* graph, Vertex* source, Vertex* sink) {
+    network.build(graph, source, sink);
+    resetTrees();
+}
+
+void BoykovKolmogorov::clear() {
+    network.clear();
+    tree.clear();
+    parent.clear();
+    timestamp.clear();
+    distance.clear();
+    queued.clear();
+    active.clear();
+    orphans.clear();
+}
+
+bool BoykovKolmogorov::isBuilt() const {
+    return network.isBuilt();
+}
+
+FlowNetwork& BoykovKolmogorov::getNetwork() {
+    return network;
+}
+
+void BoykovKolmogorov::resetTrees() {
+    const int n = network.getNumberOfVertexes();
+    tree.assign(n, FREE);
+    parent.assign(n, NO_PARENT);
+    timestamp.assign(n, 0);
+    distance.assign(n, 0);
+    queued.assign(n, false);
+    active.clear();
+    orphans.clear();
+    time = 0;
+
+    tree[network.getSource()] = SOURCE_TREE;
+    tree[network.getSink()] = SINK_TREE;
+    parent[network.getSource()] = TERMINAL;
+    parent[network.getSink()] = TERMINAL;
+    activate(network.getSource());
+    activate(network.getSink());
+}
+
+void BoykovKolmogorov::markVertexDirty(Vertex* v) {
+    if (!isBuilt()) return;
+    network.refreshVertex(v);
+}
+
+void BoykovKolmogorov::markEdgeDirty(const Edge* e) {
+    if (!isBuilt()) return;
+    network.refreshEdge(e);
+}
+
+void BoykovKolmogorov::activate(const int v) {
+    if (tree[v] != FREE && !queued[v]) {
+        queued[v] = true;
+        active.push_back(v);
+    }
+}
+
+int BoykovKolmogorov::getParentVertex(const int v) const {
+    return tree[v] == SOURCE_TREE ? network.getTail(parent[v]) : network.getHead(parent[v]);
+}
+
+void BoykovKolmogorov::absorbChangedArcs() {
+    // Distances checked before the changes can no longer be trusted
+    time++;
+    for (const int a : network.takeChangedArcs()) {
+        const int from = network.getTail(a);
+        const int to = network.getHead(a);
+        if (network.getResidual(a) <= 0) {
+            if (tree[to] == SOURCE_TREE && parent[to] == a) {
+                parent[to] = ORPHAN;
+                orphans.push_back(to);
+            }
+            if (tree[from] == SINK_TREE && parent[from] == a) {
+                parent[from] = ORPHAN;
+                orphans.push_back(from);
+            }
+        }
+        // A residual capacity may have grown, so both ends have to be scanned again
+        activate(from);
+        activate(to);
+    }
+}
+
+long long BoykovKolmogorov::solve() {
+    absorbChangedArcs();
+    adopt();
+    int bridge;
+    while ((bridge = grow()) >= 0) {
+        augment(bridge);
+        adopt();
+    }
+    return network.getFlowValue();
+}
+
+int BoykovKolmogorov::grow() {
+    while (!active.empty()) {
+        const int p = active.front();
+        if (tree[p] != FREE) {
+            const bool inSourceTree = tree[p] == SOURCE_TREE;
+            for (int a = network.getFirstArc(p); a < network.getEndArc(p); a++) {
+                const int arc = inSourceTree ? a : network.getReverse(a);
+                if (network.getResidual(arc) <= 0) continue;
+                const int q = network.getHead(a);
+                if (tree[q] == FREE) {
+                    tree[q] = tree[p];
+                    parent[q] = arc;
+                    timestamp[q] = timestamp[p];
+                    distance[q] = distance[p] + 1;
+                    activate(q);
+                }
+                else if (tree[q] != tree[p]) {
+                    return arc;
+                }
+            }
+        }
+        active.pop_front();
+        queued[p] = false;
+    }
+    return -1;
+}
+
+void BoykovKolmogorov::augment(const int bridge) {
+    const int source = network.getSource();
+    const int sink = network.getSink();
+
+    // Find the bottleneck of the path
+    long long amount = network.getResidual(bridge);
+    for (int v = network.getTail(bridge); v != source; v = network.getTail(parent[v])) {
+        amount = min(amount, network.getResidual(parent[v]));
+    }
+    for (int v = network.getHead(bridge); v != sink; v = network.getHead(parent[v])) {
+        amount = min(amount, network.getResidual(parent[v]));
+    }
+
+    // Push the flow and orphan the vertexes whose tree arc was saturated
+    network.push(bridge, amount);
+    for (int v = network.getTail(bridge); v != source;) {
+        const int a = parent[v];
+        const int next = network.getTail(a);
+        network.push(a, amount);
+        if (network.getResidual(a) == 0) {
+            parent[v] = ORPHAN;
+            orphans.push_back(v);
+        }
+        v = next;
+    }
+    for (int v = network.getHead(bridge); v != sink;) {
+        const int a = parent[v];
+        const int next = network.getHead(a);
+        network.push(a, amount);
+        if (network.getResidual(a) == 0) {
+            parent[v] = ORPHAN;
+            orphans.push_back(v);
+        }
+        v = next;
+    }
+    time++;
+}
+
+void BoykovKolmogorov::adopt() {
+    while (!orphans.empty()) {
+        const int v = orphans.front();
+        orphans.pop_front();
+        if (parent[v] == ORPHAN) {
+            processOrphan(v);
+        }
+    }
+}
+
+bool BoykovKolmogorov::reachesTerminal(const int v, int& dist) {
+    // Walk up the tree until a terminal, an orphan or a vertex checked at this time
+    int d = 0;
+    int u = v;
+    while (true) {
+        if (parent[u] == ORPHAN || parent[u] == NO_PARENT) {
+            return false;
+        }
+        if (timestamp[u] == time) {
+            d += distance[u];
+            break;
+        }
+        if (parent[u] == TERMINAL) {
+            timestamp[u] = time;
+            distance[u] = 0;
+            break;
+        }
+        d++;
+        u = getParentVertex(u);
+    }
+    dist = d;
+
+    // Cache the distances along the path
+    for (u = v; timestamp[u] != time; u = getParentVertex(u)) {
+        timestamp[u] = time;
+        distance[u] = d--;
+    }
+    return true;
+}
+
+void BoykovKolmogorov::processOrphan(const int v) {
+    const bool inSourceTree = tree[v] == SOURCE_TREE;
+    int bestArc = NO_PARENT;
+    int bestDistance = INT_MAX;
+
+    for (int a = network.getFirstArc(v); a < network.getEndArc(v); a++) {
+        const int q = network.getHead(a);
+        if (tree[q] != tree[v]) continue;
+        // In the source tree the parent sends flow to v, in the sink tree v sends flow to the parent
+        const int arc = inSourceTree ? network.getReverse(a) : a;
+        if (network.getResidual(arc) <= 0) continue;
+        int d;
+        if (reachesTerminal(q, d) && d < bestDistance) {
+            bestArc = arc;
+            bestDistance = d;
+        }
+    }
+
+    if (bestArc != NO_PARENT) {
+        parent[v] = bestArc;
+        timestamp[v] = time;
+        distance[v] = bestDistance + 1;
+        return;
+    }
+
+    // No parent was found, so v leaves its tree and its children become orphans
+    for (int a = network.getFirstArc(v); a < network.getEndArc(v); a++) {
+        const int q = network.getHead(a);
+        if (tree[q] != tree[v]) continue;
+        const int arc = inSourceTree ? network.getReverse(a) : a;
+        if (network.getResidual(arc) > 0) {
+            activate(q);
+        }
+        if (parent[q] >= 0 && getParentVertex(q) == v) {
+            parent[q] = ORPHAN;
+            orphans.push_back(q);
+        }
+    }
+    tree[v] = FREE;
+    parent[v] = NO_PARENT;
+}
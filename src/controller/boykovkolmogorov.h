@@ -0,0 +1,159 @@
+#ifndef PROJECTDA_BOYKOVKOLMOGOROV_H
+#define PROJECTDA_BOYKOVKOLMOGOROV_H
+/**
+* @file boykovkolmogorov.h
+* @brief This file contains the Boykov-Kolmogorov max-flow engine header.
+ */
+
+// Project headers
+#include "../model/FlowNetwork.h"
+// Standard library headers
+#include <deque>
+#include <vector>
+using namespace std;
+
+/**
+ * @class BoykovKolmogorov
+ * @brief Max-flow engine that keeps its search trees and its flow between solves.
+ *
+ * The engine grows a tree from the super source and a tree from the super sink over the residual network until they
+ * touch, augments along the path found and then adopts the vertexes that lost their parent (orphans). The trees
+ * and the flow are kept after a solve, so after a few vertexes or pipes are disabled or enabled (marked dirty) the
+ * next solve only cancels the flow that went through them and repairs the orphaned regions of the trees.
+ */
+class BoykovKolmogorov {
+public:
+    /**
+     * @brief Builds the network from the graph and starts new search trees.
+     *
+     * Time complexity: O(V + E)
+     *
+     * @param graph Pointer to the graph, with the super source and super sink already added.
+     * @param source Pointer to the super source vertex.
+     * @param sink Pointer to the super sink vertex.
+     */
+    void build(Graph* graph, Vertex* source, Vertex* sink);
+
+    /**
+     * @brief Drops the network and the search trees.
+     *
+     * Time complexity: O(1)
+     */
+    void clear();
+
+    /**
+     * @brief Checks if the engine has a network.
+     *
+     * Time complexity: O(1)
+     *
+     * @return True if the engine was built and not cleared, false otherwise.
+     */
+    bool isBuilt() const;
+
+    /**
+     * @brief Marks a vertex whose enabled state changed.
+     *
+     * The capacities of the arcs of the vertex are updated, the flow that goes through it is cancelled when it is
+     * disabled and the affected tree regions are repaired on the next solve.
+     *
+     * Time complexity: O(d * (V + E)) in the worst case, where d is the degree of the vertex.
+     *
+     * @param v Pointer to the vertex.
+     */
+    void markVertexDirty(Vertex* v);
+
+    /**
+     * @brief Marks a pipe whose enabled state changed.
+     *
+     * Time complexity: O(V + E) in the worst case.
+     *
+     * @param e Pointer to the edge.
+     */
+    void markEdgeDirty(const Edge* e);
+
+    /**
+     * @brief Computes the maximum flow, starting from the current flow and search trees.
+     *
+     * Time complexity: O(V * E^2 * |C|) in the worst case, where |C| is the capacity of the minimum cut. In practice
+     * it is close to linear and a solve after marking a few elements dirty only visits the repaired regions.
+     *
+     * @return The value of the maximum flow.
+     */
+    long long solve();
+
+    /**
+     * @brief Gets the network used by the engine.
+     *
+     * Time complexity: O(1)
+     *
+     * @return Reference to the network.
+     */
+    FlowNetwork& getNetwork();
+
+private:
+    /**
+     * @brief Restarts the search trees with only the terminals.
+     */
+    void resetTrees();
+
+    /**
+     * @brief Marks the arcs changed outside of the engine, orphaning the vertexes whose tree arc was saturated.
+     */
+    void absorbChangedArcs();
+
+    /**
+     * @brief Adds a vertex of a tree to the active queue.
+     * @param v Index of the vertex.
+     */
+    void activate(int v);
+
+    /**
+     * @brief Grows the trees until they touch.
+     * @return The arc from the source tree to the sink tree, or -1 if there is no augmenting path.
+     */
+    int grow();
+
+    /**
+     * @brief Augments along the path through an arc, orphaning the vertexes whose tree arc gets saturated.
+     * @param bridge The arc from the source tree to the sink tree.
+     */
+    void augment(int bridge);
+
+    /**
+     * @brief Finds a new parent for each orphan or frees it.
+     */
+    void adopt();
+
+    /**
+     * @brief Finds a new parent for one orphan or frees it.
+     * @param v Index of the orphan.
+     */
+    void processOrphan(int v);
+
+    /**
+     * @brief Gets the parent vertex of a vertex in its tree.
+     * @param v Index of the vertex.
+     * @return Index of the parent vertex.
+     */
+    int getParentVertex(int v) const;
+
+    /**
+     * @brief Checks if a vertex is connected to its terminal through its tree.
+     * @param v Index of the vertex.
+     * @param distance Set to the number of arcs to the terminal.
+     * @return True if the vertex reaches the terminal, false otherwise.
+     */
+    bool reachesTerminal(int v, int& distance);
+
+    FlowNetwork network; /**< The residual network. */
+    vector<char> tree; /**< Tree of each vertex (free, source or sink). */
+    vector<int> parent; /**< Arc to the parent of each vertex in its tree. */
+    vector<int> timestamp; /**< Time at which the distance of each vertex was last checked. */
+    vector<int> distance; /**< Distance of each vertex to its terminal. */
+    vector<char> queued; /**< Whether each vertex is in the active queue. */
+    deque<int> active; /**< Active vertexes, whose neighbours still have to be scanned. */
+    deque<int> orphans; /**< Vertexes that lost their parent. */
+    int time = 0; /**< Current time, increased after every augmentation. */
+};
+
+#endif //PROJECTDA_BOYKOVKOLMOGOROV_H
@@ -0,0 +1,45 @@
+/**
+* @file csvreader.cpp
+* @brief This file contains the CSV row reader implementation.
+ */
+
+// Project headers
+#include "csvreader.h"
+// Standard library headers
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+CsvReader::CsvReader(const string& path) : fin(path) {
+    if (!fin.is_open()) {
+        cerr << "Error: Unable to open file." << endl;
+        exit(EXIT_FAILURE);
+    }
+    if (getline(fin, line)) {
+        splitLine(line, header);
+    }
+}
+
+bool CsvReader::readRow(vector<string>& row) {
+    while (getline(fin, line)) {
+        splitLine(line, row);
+        if (!row.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CsvReader::splitLine(string& line, vector<string>& row) {
+    string word;
+    row.clear();
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    stringstream ss(line);
+    while (getline(ss, word, ',')) {
+        if (!word.empty()) {
+            row.push_back(word);
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef PROJECTDA_CSVREADER_H
+#define PROJECTDA_CSVREADER_H
+/**
+* @file csvreader.h
+* @brief This file contains the CSV row reader header.
+ */
+
+// Standard library headers
+#include <fstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * @class CsvReader
+ * @brief Reads the rows of a data set CSV file, one at a time.
+ *
+ * The header line is kept apart from the rows, a trailing '\r' is removed from every line and the fields are split
+ * on ',', dropping the empty ones. Lines without fields are skipped.
+ */
+class CsvReader {
+public:
+    /**
+     * @brief Opens a CSV file and reads its header.
+     *
+     * Prints an error and terminates the program if the file can't be opened.
+     *
+     * Time complexity: O(H), where H is the length of the header.
+     *
+     * @param path The path of the file.
+     */
+    explicit CsvReader(const string& path);
+
+    /**
+     * @brief Reads the next row.
+     *
+     * Time complexity: O(L), where L is the length of the line.
+     *
+     * @param row Set to the fields of the row.
+     * @return True if a row was read, false at the end of the file.
+     */
+    bool readRow(vector<string>& row);
+
+    /**
+     * @brief Gets the fields of the header.
+     * @return The fields, empty if the file is empty.
+     */
+    const vector<string>& getHeader() const { return header; }
+
+private:
+    /**
+     * @brief Splits a line into its fields.
+     * @param line The line, without its trailing '\r' after the call.
+     * @param row Set to the fields of the line.
+     */
+    static void splitLine(string& line, vector<string>& row);
+
+    ifstream fin; /**< The file. */
+    string line; /**< Buffer of the current line. */
+    vector<string> header; /**< Fields of the header. */
+};
+
+#endif //PROJECTDA_CSVREADER_H
@@ -0,0 +1,107 @@
+/**
+* @file dominatortree.cpp
+* @brief This file contains the dominator tree implementation.
+ */
+
+// Project headers
+#include "dominatortree.h"
+
+DominatorTree::DominatorTree(const int n, const vector<pair<int,int>>& arcs, const int root) : idom(n, -1), enter(n, -1), leave(n, -1) {
+    // Successors and predecessors of each vertex, in compressed rows
+    vector<int> firstOut(n + 1, 0), firstIn(n + 1, 0);
+    for (const auto& [u, v] : arcs) {
+        firstOut[u + 1]++;
+        firstIn[v + 1]++;
+    }
+    for (int v = 0; v < n; v++) {
+        firstOut[v + 1] += firstOut[v];
+        firstIn[v + 1] += firstIn[v];
+    }
+    vector<int> out(arcs.size()), in(arcs.size());
+    vector<int> nextOut(firstOut.begin(), firstOut.end() - 1), nextIn(firstIn.begin(), firstIn.end() - 1);
+    for (const auto& [u, v] : arcs) {
+        out[nextOut[u]++] = v;
+        in[nextIn[v]++] = u;
+    }
+
+    // Depth-first search from the root, numbering the vertexes in preorder
+    vector<int> number(n, -1), vertex, parent(n, -1);
+    vector<pair<int,int>> stack = {{root, firstOut[root]}};
+    number[root] = 0;
+    vertex.push_back(root);
+    while (!stack.empty()) {
+        auto& [v, next] = stack.back();
+        if (next == firstOut[v + 1]) {
+            stack.pop_back();
+            continue;
+        }
+        const int w = out[next++];
+        if (number[w] >= 0) continue;
+        number[w] = static_cast<int>(vertex.size());
+        vertex.push_back(w);
+        parent[w] = v;
+        stack.emplace_back(w, firstOut[w]);
+    }
+
+    // Semidominators in reverse preorder, each vertex linked to its parent once it is processed
+    vector<int> semi(number), label(n), ancestor(n, -1), path;
+    vector<vector<int>> bucket(n);
+    for (int v = 0; v < n; v++) label[v] = v;
+    auto eval = [&](const int v) {
+        if (ancestor[v] < 0) return v;
+        int x = v;
+        while (ancestor[ancestor[x]] >= 0) {
+            path.push_back(x);
+            x = ancestor[x];
+        }
+        // Compress from the top of the path down, so every label sees the labels above it
+        while (!path.empty()) {
+            x = path.back();
+            path.pop_back();
+            const int a = ancestor[x];
+            if (semi[label[a]] < semi[label[x]]) label[x] = label[a];
+            ancestor[x] = ancestor[a];
+        }
+        return label[v];
+    };
+    for (int i = static_cast<int>(vertex.size()) - 1; i > 0; i--) {
+        const int w = vertex[i];
+        for (int a = firstIn[w]; a < firstIn[w + 1]; a++) {
+            if (number[in[a]] < 0) continue;
+            const int u = eval(in[a]);
+            if (semi[u] < semi[w]) semi[w] = semi[u];
+        }
+        bucket[vertex[semi[w]]].push_back(w);
+        ancestor[w] = parent[w];
+        for (const int v : bucket[parent[w]]) {
+            const int u = eval(v);
+            idom[v] = semi[u] < semi[v] ? u : parent[w];
+        }
+        bucket[parent[w]].clear();
+    }
+    for (size_t i = 1; i < vertex.size(); i++) {
+        const int w = vertex[i];
+        if (idom[w] != vertex[semi[w]]) idom[w] = idom[idom[w]];
+    }
+
+    // Entry and exit times of a walk of the tree
+    vector<int> firstChild(n + 1, 0), children(vertex.size());
+    for (size_t i = 1; i < vertex.size(); i++) firstChild[idom[vertex[i]] + 1]++;
+    for (int v = 0; v < n; v++) firstChild[v + 1] += firstChild[v];
+    vector<int> nextChild(firstChild.begin(), firstChild.end() - 1);
+    for (size_t i = 1; i < vertex.size(); i++) children[nextChild[idom[vertex[i]]]++] = vertex[i];
+    int time = 0;
+    stack.assign(1, {root, firstChild[root]});
+    enter[root] = time++;
+    while (!stack.empty()) {
+        auto& [v, next] = stack.back();
+        if (next == firstChild[v + 1]) {
+            leave[v] = time++;
+            stack.pop_back();
+            continue;
+        }
+        const int w = children[next++];
+        enter[w] = time++;
+        stack.emplace_back(w, firstChild[w]);
+    }
+}
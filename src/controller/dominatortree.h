@@ -0,0 +1,68 @@
+#ifndef PROJECTDA_DOMINATORTREE_H
+#define PROJECTDA_DOMINATORTREE_H
+/**
+* @file dominatortree.h
+* @brief This file contains the dominator tree header.
+ */
+
+// Standard library headers
+#include <utility>
+#include <vector>
+using namespace std;
+
+/**
+ * @class DominatorTree
+ * @brief The dominators of the vertexes of a directed graph reachable from a root.
+ *
+ * A vertex u dominates a vertex v when every path from the root to v passes through u, so removing u cuts v off
+ * from the root. The immediate dominators are computed with the Lengauer-Tarjan algorithm, with path compression on
+ * the forest of the depth-first search, and every query on the tree is answered in constant time from the entry and
+ * exit times of a walk of the tree. Both searches are iterative, so deep graphs can't overflow the stack.
+ */
+class DominatorTree {
+public:
+    /**
+     * @brief Computes the dominator tree of a graph.
+     *
+     * Time complexity: O(E * log(V))
+     *
+     * @param n The number of vertexes, indexed from 0.
+     * @param arcs Origin and destination of each arc.
+     * @param root The root.
+     */
+    DominatorTree(int n, const vector<pair<int,int>>& arcs, int root);
+
+    /**
+     * @brief Checks if a vertex is reachable from the root.
+     * @param v The vertex.
+     * @return True if it is reachable, false otherwise.
+     */
+    bool isReachable(int v) const { return enter[v] >= 0; }
+
+    /**
+     * @brief Gets the immediate dominator of a vertex, the dominator closest to it.
+     * @param v The vertex.
+     * @return The immediate dominator, or -1 for the root and the vertexes that aren't reachable.
+     */
+    int getImmediateDominator(int v) const { return idom[v]; }
+
+    /**
+     * @brief Checks if a vertex dominates another.
+     *
+     * Time complexity: O(1)
+     *
+     * @param u The possible dominator.
+     * @param v The vertex.
+     * @return True if both are reachable and every path from the root to v passes through u, false otherwise.
+     */
+    bool dominates(int u, int v) const {
+        return isReachable(u) && isReachable(v) && enter[u] <= enter[v] && leave[v] <= leave[u];
+    }
+
+private:
+    vector<int> idom; /**< Immediate dominator of each vertex. */
+    vector<int> enter; /**< Entry time of each vertex in the walk of the tree, -1 if it isn't reachable. */
+    vector<int> leave; /**< Exit time of each vertex in the walk of the tree. */
+};
+
+#endif //PROJECTDA_DOMINATORTREE_H
@@ -0,0 +1,144 @@
+/**
+* @file filewatcher.cpp
+* @brief This file contains the file watcher implementation.
+ */
+
+// Project headers
+#include "filewatcher.h"
+// Standard library headers
+#include <chrono>
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#else
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+#include <thread>
+#endif
+
+FileWatcher::FileWatcher(const vector<string>& paths) {
+    for (const string& path : paths) {
+        const size_t slash = path.find_last_of('/');
+        const string directory = slash == string::npos ? "." : path.substr(0, slash == 0 ? 1 : slash);
+        names.push_back(slash == string::npos ? path : path.substr(slash + 1));
+        size_t d = 0;
+        while (d < directories.size() && directories[d] != directory) d++;
+        if (d == directories.size()) directories.push_back(directory);
+        directoryOf.push_back(static_cast<int>(d));
+    }
+#ifdef __linux__
+    fd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if (fd < 0) return;
+    for (const string& directory : directories) {
+        const int wd = inotify_add_watch(fd, directory.c_str(),
+                                         IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO);
+        if (wd < 0) return;
+        descriptors.push_back(wd);
+    }
+#else
+    this->paths = paths;
+    status = getStatus();
+#endif
+    watching = true;
+}
+
+FileWatcher::~FileWatcher() {
+#ifdef __linux__
+    if (fd >= 0) close(fd);
+#endif
+}
+
+bool FileWatcher::waitForChange(int debounceMilliseconds) {
+    if (!watching) return false;
+    int changed;
+    while ((changed = waitForEvents(-1)) == 0) {}
+    if (changed < 0) return false;
+
+    const chrono::milliseconds debounce(debounceMilliseconds);
+    auto deadline = chrono::steady_clock::now() + debounce;
+    while (true) {
+        const auto now = chrono::steady_clock::now();
+        if (now >= deadline) return true;
+        const auto remaining = chrono::ceil<chrono::milliseconds>(deadline - now);
+        changed = waitForEvents(static_cast<int>(remaining.count()));
+        if (changed < 0) return false;
+        if (changed > 0) deadline = chrono::steady_clock::now() + debounce;
+    }
+}
+
+#ifdef __linux__
+
+int FileWatcher::waitForEvents(int timeoutMilliseconds) {
+    pollfd ready = {fd, POLLIN, 0};
+    const int count = poll(&ready, 1, timeoutMilliseconds);
+    if (count < 0) return errno == EINTR ? 0 : -1;
+    if (count == 0) return 0;
+
+    alignas(inotify_event) char buffer[4096];
+    int changed = 0;
+    while (true) {
+        const ssize_t length = read(fd, buffer, sizeof(buffer));
+        if (length < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) break;
+            watching = false;
+            return -1;
+        }
+        for (ssize_t i = 0; i < length;) {
+            const auto event = reinterpret_cast<const inotify_event*>(buffer + i);
+            i += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            if (event->mask & IN_Q_OVERFLOW) {
+                changed = 1;
+                continue;
+            }
+            if (event->mask & IN_IGNORED) {
+                // The directory was removed, nothing else will be reported
+                watching = false;
+                return -1;
+            }
+            if (event->len == 0) continue;
+            for (size_t f = 0; f < names.size(); f++) {
+                if (descriptors[directoryOf[f]] == event->wd && names[f] == event->name) changed = 1;
+            }
+        }
+    }
+    return changed;
+}
+
+#else
+
+int FileWatcher::waitForEvents(int timeoutMilliseconds) {
+    const chrono::milliseconds interval(100);
+    const auto start = chrono::steady_clock::now();
+    while (true) {
+        auto current = getStatus();
+        if (current != status) {
+            status = std::move(current);
+            return 1;
+        }
+        const auto elapsed = chrono::steady_clock::now() - start;
+        if (timeoutMilliseconds >= 0 && elapsed >= chrono::milliseconds(timeoutMilliseconds)) return 0;
+        chrono::milliseconds wait = interval;
+        if (timeoutMilliseconds >= 0) {
+            wait = min(wait, chrono::milliseconds(timeoutMilliseconds) - chrono::duration_cast<chrono::milliseconds>(elapsed));
+        }
+        this_thread::sleep_for(wait);
+    }
+}
+
+vector<pair<long long, long long>> FileWatcher::getStatus() const {
+    vector<pair<long long, long long>> current;
+    for (const string& path : paths) {
+        error_code error;
+        const auto time = filesystem::last_write_time(path, error);
+        const auto size = error ? 0 : filesystem::file_size(path, error);
+        if (error) current.emplace_back(-1, -1);
+        else current.emplace_back(static_cast<long long>(time.time_since_epoch().count()), static_cast<long long>(size));
+    }
+    return current;
+}
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef PROJECTDA_FILEWATCHER_H
+#define PROJECTDA_FILEWATCHER_H
+/**
+* @file filewatcher.h
+* @brief This file contains the file watcher header.
+ */
+
+// Standard library headers
+#include <string>
+#include <utility>
+#include <vector>
+using namespace std;
+
+/**
+ * @class FileWatcher
+ * @brief Waits for changes to a set of files.
+ *
+ * On Linux the directories of the files are watched with inotify, so the watcher sleeps until the kernel reports a
+ * change; the directories are watched instead of the files so files replaced by a rename, as most editors save them,
+ * are still seen. On other systems the modification time and size of the files are polled.
+ *
+ * A burst of changes, like the four data set files being copied one after the other, is reported as a single change
+ * once the files have been quiet for the debounce interval.
+ */
+class FileWatcher {
+public:
+    /**
+     * @brief Starts watching files.
+     *
+     * Time complexity: O(F), where F is the number of files.
+     *
+     * @param paths The paths of the files.
+     */
+    explicit FileWatcher(const vector<string>& paths);
+
+    /**
+     * @brief Stops watching the files.
+     *
+     * Time complexity: O(D), where D is the number of directories watched.
+     */
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+     * @brief Checks if the files are being watched.
+     * @return False if the directories couldn't be watched, true otherwise.
+     */
+    bool isWatching() const { return watching; }
+
+    /**
+     * @brief Blocks until a file changes and then until no file changed for the debounce interval.
+     *
+     * Time complexity: O(E), where E is the number of changes reported while waiting.
+     *
+     * @param debounceMilliseconds The debounce interval, in milliseconds.
+     * @return True if a file changed, false if the files can't be watched.
+     */
+    bool waitForChange(int debounceMilliseconds);
+
+private:
+    /**
+     * @brief Waits for changes to the files.
+     * @param timeoutMilliseconds How long to wait, or -1 to wait until a change.
+     * @return 1 if a file changed, 0 if none changed before the timeout, -1 if the files can't be watched.
+     */
+    int waitForEvents(int timeoutMilliseconds);
+
+    vector<string> directories; /**< The directories of the files. */
+    vector<string> names; /**< The name of each file, without its directory. */
+    vector<int> directoryOf; /**< Index in directories of the directory of each file. */
+    bool watching = false; /**< Whether the files are being watched. */
+#ifdef __linux__
+    int fd = -1; /**< The inotify instance. */
+    vector<int> descriptors; /**< The inotify watch of each directory. */
+#else
+    /**
+     * @brief Gets the modification time and size of every file, -1 for the missing ones.
+     */
+    vector<pair<long long, long long>> getStatus() const;
+
+    vector<string> paths; /**< The paths of the files. */
+    vector<pair<long long, long long>> status; /**< Modification time and size of every file, last time they were polled. */
+#endif
+};
+
+#endif //PROJECTDA_FILEWATCHER_H
@@ -7,11 +7,17 @@
 #include "manager.h"
 // Standard Library Headers
 #include <algorithm>
+#include <chrono>
 #include <climits>
 #include <iostream>
 #include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <numeric>
 #include <queue>
 #include <sstream>
+#include <unordered_set>
 #include <vector>
 
 #define ANSI_COLOR_RED "\x1b[31m"
@@ -26,9 +32,13 @@ Manager::~Manager() {
     delete graph;
 }
 void Manager::resetManager() {
+    bk.clear();
     delete this->graph;
     this->graph = new Graph();
     cities.clear();
+    cityTable.clear();
+    pipeTable.clear();
+    names.clear();
     reservoirs.clear();
     stations.clear();
 }
@@ -42,6 +52,9 @@ int Manager::getHowManyEdges() const {
 }
 
 void Manager::resetGraph() {
+    Tracer::Scope scope("reset graph");
+    SOLVER_COUNT(const auto start = chrono::steady_clock::now());
+    bk.clear();
     Vertex* superSource = findVertexInMap("SR");
     Vertex* superSink = findVertexInMap("SS");
 
@@ -78,7 +91,10 @@ void Manager::resetGraph() {
     if(superSink != nullptr) {
         graph->removeVertex(superSink);
         cities.erase("SS");
+        cityTable.clearSinkEdges();
     }
+    SOLVER_COUNT(counters.resets++);
+    SOLVER_COUNT(counters.resetNanoseconds += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
 }
 
 Graph* Manager::getGraph() const {
@@ -111,113 +127,131 @@ Vertex* Manager::findVertexInMap(const string& identifier) const {
 }
 /*------------- Csv methods -----------------------------*/
 
-void Manager::createCsvFileFlows(const string &path,vector<pair<string,int>>& flows) {
-    ofstream outputCSV(path);
-
-    if (!outputCSV.is_open()) {
-        cerr << "Error: Unable to open file." << endl;
-        exit(EXIT_FAILURE);
+const string& Manager::getCachedName(const string& code) {
+    auto it = names.find(code);
+    if (it == names.end()) {
+        it = names.emplace(code, Graph::getName(findVertexInMap(code))).first;
     }
+    return it->second;
+}
 
-    outputCSV << "Name,Code,Flow" << endl;
+void Manager::createCsvFileFlows(const string &path,vector<pair<string,int>>& flows) {
+    ostringstream outputCSV;
+
+    outputCSV << "Name,Code,Flow" << '\n';
 
-    for (const auto flow : flows) {
-        outputCSV << Graph::getName(findVertexInMap(flow.first)) << "," << flow.first << "," << flow.second << endl;
+    for (const auto& flow : flows) {
+        outputCSV << getCachedName(flow.first) << "," << flow.first << "," << flow.second << '\n';
     }
 
-    outputCSV.flush();
-    outputCSV.close();
+    resultWriter.write(path, outputCSV.str());
 }
 
 void Manager::createCsvFileDisable(const string &path, vector<pair<string, bool> > &disable) {
-    ofstream outputCSV(path);
+    ostringstream outputCSV;
 
-    if (!outputCSV.is_open()) {
-        cerr << "Error: Unable to open file." << endl;
-        exit(EXIT_FAILURE);
-    }
+    outputCSV << "Code,CanBeDisabled" << '\n';
 
-    outputCSV << "Code,CanBeDisabled" << endl;
-
-    for (const auto station : disable) {
+    for (const auto& station : disable) {
         if (station.second)
-            outputCSV << station.first << "," << "yes" << endl;
-        else outputCSV << station.first << "," << "no" << endl;
+            outputCSV << station.first << "," << "yes" << '\n';
+        else outputCSV << station.first << "," << "no" << '\n';
     }
 
-    outputCSV.flush();
-    outputCSV.close();
+    resultWriter.write(path, outputCSV.str());
 }
 
 void Manager::createCsvFilePipesDisable(const string &path, vector<pair<Edge*, bool>> &disable) {
-    ofstream outputCSV(path);
+    ostringstream outputCSV;
 
-    if (!outputCSV.is_open()) {
-        cerr << "Error: Unable to open file." << endl;
-        exit(EXIT_FAILURE);
-    }
-
-    outputCSV << "Origin,Destination,CanBeDisabled" << endl;
+    outputCSV << "Origin,Destination,CanBeDisabled" << '\n';
 
-    for (const auto pipe : disable) {
+    for (const auto& pipe : disable) {
         if (pipe.second)
-            outputCSV << Graph::getCode(pipe.first->getOrigin()) << "," << Graph::getCode(pipe.first->getDest()) << "," << "yes" << endl;
-        else outputCSV << Graph::getCode(pipe.first->getOrigin()) << "," << Graph::getCode(pipe.first->getDest()) << "," << "no" << endl;
+            outputCSV << Graph::getCode(pipe.first->getOrigin()) << "," << Graph::getCode(pipe.first->getDest()) << "," << "yes" << '\n';
+        else outputCSV << Graph::getCode(pipe.first->getOrigin()) << "," << Graph::getCode(pipe.first->getDest()) << "," << "no" << '\n';
     }
 
-    outputCSV.flush();
-    outputCSV.close();
+    resultWriter.write(path, outputCSV.str());
 }
 
 
 
 void Manager::createCsvFileEnoughWater(const string &path, vector<pair<string, bool>>& enoughWater) {
-    ofstream outputCSV(path);
+    ostringstream outputCSV;
 
-    if (!outputCSV.is_open()) {
-        cerr << "Error: Unable to open file." << endl;
-        exit(EXIT_FAILURE);
-    }
-
-    outputCSV << "Code,EnoughWater" << endl;
+    outputCSV << "Code,EnoughWater" << '\n';
 
-    for (const auto city : enoughWater) {
+    for (const auto& city : enoughWater) {
         if (city.second)
-            outputCSV << city.first << "," << "yes" << endl;
-        else outputCSV << city.first << "," << "no" << endl;
+            outputCSV << city.first << "," << "yes" << '\n';
+        else outputCSV << city.first << "," << "no" << '\n';
     }
 
-    outputCSV.flush();
-    outputCSV.close();
+    resultWriter.write(path, outputCSV.str());
 }
 
 
 void Manager::createCsvFileRates(const string &path, vector<pair<string, double> > &rates) {
-    ofstream outputCSV(path);
+    ostringstream outputCSV;
 
-    if (!outputCSV.is_open()) {
-        cerr << "Error: Unable to open file." << endl;
-        exit(EXIT_FAILURE);
+    outputCSV << "Name,Code,Rate" << '\n';
+
+    for (const auto& rate : rates) {
+        outputCSV << getCachedName(rate.first) << "," << rate.first << "," << rate.second << "%" << '\n';
     }
 
-    outputCSV << "Name,Code,Rate" << endl;
+    resultWriter.write(path, outputCSV.str());
+}
 
-    for (const auto rate : rates) {
-        if (rate.second < 0) {
-            outputCSV << Graph::getName(findVertexInMap(rate.first)) << "," << rate.first << "," << rate.second << "%" << endl;
-        }
-        else {
-            outputCSV << Graph::getName(findVertexInMap(rate.first)) << "," << rate.first << "," << rate.second << "%" << endl;
-        }
+void Manager::createCsvFileFlowPaths(const string &path, const FlowDecomposition& decomposition) {
+    ostringstream outputCSV;
+
+    writeFlowPaths(outputCSV, decomposition);
+
+    resultWriter.write(path, outputCSV.str());
+}
+
+void Manager::createCsvFileAttribution(const string &path, const AttributionMatrix& matrix) {
+    ostringstream outputCSV;
+
+    writeAttribution(outputCSV, matrix);
+
+    resultWriter.write(path, outputCSV.str());
+}
+
+void Manager::createCsvFileMinCut(const string &path, const MinCut& cut) {
+    ostringstream outputCSV;
+
+    writeMinCut(outputCSV, cut);
+
+    resultWriter.write(path, outputCSV.str());
+}
+
+void Manager::createCsvFileCriticality(const string &path, const Criticality& criticality) {
+    ostringstream outputCSV;
+
+    writeCriticality(outputCSV, criticality);
+
+    resultWriter.write(path, outputCSV.str());
+}
+
+void Manager::createCsvFileDeficits(const string &path, const vector<int>& supplied, const vector<int>& deficits) {
+    ostringstream outputCSV;
+
+    outputCSV << "Code,Demand,Flow,Deficit" << '\n';
+
+    for (int i = 0; i < cityTable.getNumberOfCities(); i++) {
+        outputCSV << cityTable.getCode(i) << "," << cityTable.getDemand(i) << "," << supplied[i] << "," << deficits[i] << '\n';
     }
 
-    outputCSV.flush();
-    outputCSV.close();
+    resultWriter.write(path, outputCSV.str());
 }
 
 /*------------- Parsing methods ------------------------ */
 
 void Manager::importFiles(const string& pathCities,const string& pathReservoirs,const string& pathStations,const string& pathPipes) {
+    Tracer::Scope scope("import");
     resetManager();
     importCities(pathCities);
     importStations(pathStations);
@@ -236,173 +270,468 @@ int Manager::parseInt(const string& text) const {
     return number_integer;
 }
 
-void Manager::importCities(const string& pathCities){
-    fstream fin;
-    fin.open(pathCities,ios::in);
+City* Manager::parseCity(const vector<string>& row) const {
+    int population;
+    if (row[4].at(0) == '\"') {
+        string populationStr = row[4] + row[5];
+        population = parseInt(populationStr);
+    }
+    else {
+        population = stoi(row[4]);
+    }
+    return new City(row[0],stoi(row[1]),row[2],stoi(row[3]),population);
+}
+
+Reservoir* Manager::parseReservoir(const vector<string>& row) {
+    return new Reservoir(row[0],row[1],stoi(row[2]),row[3],stoi(row[4]));
+}
 
-    if (!fin.is_open()) {
-        cerr << "Error: Unable to open file." << endl;
+Station* Manager::parseStation(const vector<string>& row) {
+    return new Station(stoi(row[0]),row[1]);
+}
+
+int Manager::parseDirection(const vector<string>& row) {
+    const int direction = stoi(row[3]);
+    if (direction != 0 && direction != 1) {
+        cerr << "This value is not accepted for direction of edges" << endl;
         exit(EXIT_FAILURE);
     }
+    return direction;
+}
 
+void Manager::importCities(const string& pathCities){
+    CsvReader reader(pathCities);
     vector<string> row;
-    string line;
-    string word;
-    getline(fin,line);
-    while (getline(fin,line)) {
-        row.clear(); // Empty last line
-        if (line.at(line.size()-1) == '\r') {
-            line = line.substr(0,line.size()-1);
-        }
-        stringstream ss(line);
-        while(getline(ss,word,',')){
-
-            if (!word.empty()) {
-                row.push_back(word);
-            }
-        }
-        if (row.empty()) {
-            continue;
-        }
-        int population;
-        if (row[4].at(0) == '\"') {
-            string populationStr = row[4] + row[5];
-            population = parseInt(populationStr);
-        }
-        else {
-            population = stoi(row[4]);
+    while (reader.readRow(row)) {
+        City* city = parseCity(row);
+        if (auto [_, success] = cities.insert({city->getCode(),city});success) {
+            graph->addVertex(city);
+            cityTable.add(city);
         }
+        else delete city;
+    }
+}
 
-        Vertex* city = new City(row[0],stoi(row[1]),row[2],stoi(row[3]),population);
-        if (auto [_, success] = cities.insert({row[2],city});success) {
-            graph->addVertex(city);
+void Manager::importReservoirs(const string& pathReservoirs)  {
+    CsvReader reader(pathReservoirs);
+    vector<string> row;
+    while (reader.readRow(row)) {
+        Reservoir* reservoir = parseReservoir(row);
+        if (auto [_, success] = reservoirs.insert({reservoir->getCode(), reservoir});success) {
+           graph->addVertex(reservoir);
         }
+        else delete reservoir;
+    }
+}
 
+void Manager::importStations(const string& pathStations) {
+    CsvReader reader(pathStations);
+    vector<string> row;
+    while (reader.readRow(row)) {
+        Station* station = parseStation(row);
+        if (auto [_, success] = stations.insert({station->getCode(),station});success) {
+            graph->addVertex(station);
+        }
+        else delete station;
     }
-    fin.close();
 }
 
-void Manager::importReservoirs(const string& pathReservoirs)  {
-    fstream fin;
-    fin.open(pathReservoirs,ios::in);
-    // Check if the file is open
-    if (!fin.is_open()) {
-        cerr << "Error: Unable to open file." << endl;
-        exit(EXIT_FAILURE);
+void Manager::importPipes(const string& pathPipes) {
+    CsvReader reader(pathPipes);
+    vector<string> row;
+    while (reader.readRow(row)) {
+        Vertex* orig = findVertexInMap(row[0]);
+        Vertex* dest = findVertexInMap(row[1]);
+        const int capacity = stoi(row[2]);
+
+        if (parseDirection(row) == 0) {
+            // A repeated pipe gets no edge
+            if (Edge* e = graph->addEdge(orig,dest,capacity,"normal"); e != nullptr) pipeTable.add(e);
+        }
+        else {
+            Edge* e1 = graph->addEdge(orig,dest,capacity,"normal");
+            Edge* e2 = graph->addEdge(dest,orig,capacity,"normal");
+            e1->setReverseEdge(e2);
+            e2->setReverseEdge(e1);
+            pipeTable.add(e1);
+            pipeTable.add(e2);
+        }
     }
+}
+
+/*------------- Delta import --------------------------- */
 
+ImportDelta Manager::reimportFiles(const string& pathCities,const string& pathReservoirs,const string& pathStations,const string& pathPipes) {
+    Tracer::Scope scope("reimport");
+    ImportDelta delta;
+    vector<pair<int,int>> demands; // Index of the city and new demand
+    vector<pair<Reservoir*,int>> deliveries;
+    vector<pair<Edge*,int>> capacities;
     vector<string> row;
-    string line;
-    string word;
-    getline(fin,line);
-    while (getline(fin,line)) {
-        row.clear(); // Empty last line
-        if (line.at(line.size()-1) == '\r') {
-            line = line.substr(0,line.size()-1);
-        }
-        stringstream ss(line);
-        while(getline(ss,word,',')){
-
-            if (!word.empty()) {
-                row.push_back(word);
+
+    unordered_set<string> seen;
+    CsvReader cityReader(pathCities);
+    while (cityReader.readRow(row)) {
+        const City* city = parseCity(row);
+        const auto it = cities.find(city->getCode());
+        if (!seen.insert(city->getCode()).second) {
+            // Repeated rows are ignored, like in importCities
+        }
+        else if (it == cities.end() || it->first == "SS") {
+            delta.addedVertexes++;
+        }
+        else {
+            const auto old = static_cast<const City*>(it->second);
+            if (old->getName() != city->getName() || old->getId() != city->getId() || old->getPopulation() != city->getPopulation()) {
+                delta.replacedVertexes++;
+            }
+            else if (old->getDemand() != city->getDemand()) {
+                demands.emplace_back(cityTable.getIndex(city->getCode()), city->getDemand());
+                delta.changedVertexes++;
+            }
+        }
+        delete city;
+    }
+    delta.removedVertexes += static_cast<int>(cities.size() - cities.count("SS")) - static_cast<int>(seen.size() - delta.addedVertexes);
+
+    seen.clear();
+    int added = 0;
+    CsvReader reservoirReader(pathReservoirs);
+    while (reservoirReader.readRow(row)) {
+        const Reservoir* reservoir = parseReservoir(row);
+        const auto it = reservoirs.find(reservoir->getCode());
+        if (!seen.insert(reservoir->getCode()).second) {
+            // Repeated rows are ignored, like in importReservoirs
+        }
+        else if (it == reservoirs.end() || it->first == "SR") {
+            added++;
+        }
+        else {
+            const auto old = static_cast<Reservoir*>(it->second);
+            if (old->getName() != reservoir->getName() || old->getMunicipality() != reservoir->getMunicipality() || old->getId() != reservoir->getId()) {
+                delta.replacedVertexes++;
+            }
+            else if (old->getMaxDelivery() != reservoir->getMaxDelivery()) {
+                deliveries.emplace_back(old, reservoir->getMaxDelivery());
+                delta.changedVertexes++;
             }
         }
-        if (row.empty()) {
+        delete reservoir;
+    }
+    delta.addedVertexes += added;
+    delta.removedVertexes += static_cast<int>(reservoirs.size() - reservoirs.count("SR")) - static_cast<int>(seen.size() - added);
+
+    seen.clear();
+    added = 0;
+    CsvReader stationReader(pathStations);
+    while (stationReader.readRow(row)) {
+        const Station* station = parseStation(row);
+        const auto it = stations.find(station->getCode());
+        if (!seen.insert(station->getCode()).second) {
+            // Repeated rows are ignored, like in importStations
+        }
+        else if (it == stations.end()) {
+            added++;
+        }
+        else if (static_cast<const Station*>(it->second)->getId() != station->getId()) {
+            delta.replacedVertexes++;
+        }
+        delete station;
+    }
+    delta.addedVertexes += added;
+    delta.removedVertexes += static_cast<int>(stations.size()) - static_cast<int>(seen.size() - added);
+
+    // Pipes of the network by origin and destination, the two directions of a pipe are two edges
+    map<pair<string,string>, Edge*> pipes;
+    for (const auto v : graph->getVertexSet()) {
+        for (const auto e : v->getAdj()) {
+            if (e->getType() == "normal") {
+                pipes[{Graph::getCode(e->getOrigin()), Graph::getCode(e->getDest())}] = e;
+            }
+        }
+    }
+    unordered_set<const Edge*> seenPipes;
+    CsvReader pipeReader(pathPipes);
+    while (pipeReader.readRow(row)) {
+        const int capacity = stoi(row[2]);
+        const bool bidirectional = parseDirection(row) == 1;
+        const auto it = pipes.find({row[0], row[1]});
+        Edge* e = it == pipes.end() ? nullptr : it->second;
+        Edge* reverse = nullptr;
+        if (e != nullptr && e->getReverseEdge() != nullptr && e->getReverseEdge()->getType() == "normal") {
+            reverse = e->getReverseEdge();
+        }
+        if (e != nullptr && seenPipes.count(e) != 0) continue; // Repeated rows are ignored, like in importPipes
+        if (e == nullptr || bidirectional != (reverse != nullptr)) {
+            delta.addedPipes++;
             continue;
         }
+        seenPipes.insert(e);
+        if (reverse != nullptr) seenPipes.insert(reverse);
+        if (e->getCapacity() != capacity) {
+            capacities.emplace_back(e, capacity);
+            if (reverse != nullptr) capacities.emplace_back(reverse, capacity);
+            delta.changedPipes++;
+        }
+    }
+    for (const auto& [_, e] : pipes) {
+        // A pipe in both directions counts once
+        if (seenPipes.count(e) == 0 && !(e->getReverseEdge() != nullptr && e->getReverseEdge()->getType() == "normal" && e->getReverseEdge() < e)) {
+            delta.removedPipes++;
+        }
+    }
 
-        Vertex* reservoir = new Reservoir(row[0],row[1],stoi(row[2]),row[3],stoi(row[4]));
-        if (auto [_, success] = reservoirs.insert({row[3], reservoir});success) {
-           graph->addVertex(reservoir);
+    if (delta.isStructural()) {
+        importFiles(pathCities, pathReservoirs, pathStations, pathPipes);
+        delta.rebuilt = true;
+        return delta;
+    }
+
+    // Apply the changes to the graph and, when there is a baseline flow, to the Boykov-Kolmogorov engine
+    for (const auto& [city, demand] : demands) {
+        cityTable.setDemand(city, demand);
+        if (Edge* e = cityTable.getSinkEdge(city); e != nullptr) {
+            setEdgeCapacity(e, demand);
         }
     }
-    fin.close();
+    Vertex* superSource = findVertexInMap("SR");
+    for (const auto& [reservoir, maxDelivery] : deliveries) {
+        reservoir->setMaxDelivery(maxDelivery);
+        if (superSource == nullptr) continue;
+        for (const auto e : superSource->getAdj()) {
+            if (e->getDest() == reservoir) setEdgeCapacity(e, maxDelivery);
+        }
+    }
+    for (const auto& [e, capacity] : capacities) {
+        setEdgeCapacity(e, capacity);
+        if (e->getReverseEdge() != nullptr && e->getReverseEdge()->getType() == "residual") {
+            e->getReverseEdge()->setCapacity(capacity);
+        }
+    }
+    return delta;
+}
 
+void Manager::setEdgeCapacity(Edge* e, const int capacity) {
+    e->setCapacity(capacity);
+    if (!bk.isBuilt()) return;
+    FlowNetwork& network = bk.getNetwork();
+    if (const int arc = network.getArc(e); arc >= 0) {
+        network.setBaseCapacity(arc, capacity);
+    }
 }
 
-void Manager::importStations(const string& pathStations) {
-    fstream fin;
-    fin.open(pathStations,ios::in);
-    if (!fin.is_open()) {
-        cerr << "Error: Unable to open file." << endl;
-        exit(EXIT_FAILURE);
+vector<pair<string,int>> Manager::maxFlowBaseline() {
+    if (!bk.isBuilt()) {
+        return maxFlowBoykovKolmogorov();
     }
+    auto flows = solveBoykovKolmogorov();
+    bk.getNetwork().writeFlows();
+    return flows;
+}
+
+long long Manager::writeBaselineResults(vector<pair<string,int>>& flows, const string& name) {
+    createCsvFileFlows(resultWriter.getPath(name + "_flows"), flows);
+    const vector<int> supplied = cityTable.getSupplied();
+    vector<int> deficits;
+    vector<unsigned char> satisfied;
+    const long long totalDeficit = cityTable.computeDeficits(supplied, deficits, satisfied);
+    createCsvFileDeficits(resultWriter.getPath(name + "_deficits"), supplied, deficits);
+    return totalDeficit;
+}
+
+/*------------- Time series ---------------------------- */
+
+TimeSeries Manager::importTimeSeries(CsvReader& reader, vector<int> columns, const string& name) const {
+    TimeSeries series(std::move(columns));
     vector<string> row;
-    string line;
-    string word;
-    getline(fin,line);
-    while (getline(fin,line)) {
-        row.clear(); // Empty last line
-        if (line.at(line.size()-1) == '\r') {
-            line = line.substr(0,line.size()-1);
+    vector<int> values(series.getNumberOfColumns());
+    while (reader.readRow(row)) {
+        if (row.size() != values.size() + 1) {
+            cerr << "Error: The step " << row[0] << " of the " << name << " doesn't have a value for every column." << endl;
+            exit(EXIT_FAILURE);
         }
-        stringstream ss(line);
-
-        while(getline(ss,word,',')){
+        for (size_t i = 1; i < row.size(); i++) {
+            values[i - 1] = parseInt(row[i]);
+        }
+        series.addStep(row[0], values);
+    }
+    return series;
+}
 
-            if (!word.empty()) {
-                row.push_back(word);
+TimeSeries Manager::importDemandProfile(const string& path) const {
+    CsvReader reader(path);
+    const vector<string>& header = reader.getHeader();
+    vector<int> columns;
+    for (size_t i = 1; i < header.size(); i++) {
+        const int city = cityTable.getIndex(header[i]);
+        if (city < 0) {
+            cerr << "Error: Unknown city " << header[i] << " in the demand profile." << endl;
+            exit(EXIT_FAILURE);
+        }
+        columns.push_back(city);
+    }
+    TimeSeries profile = importTimeSeries(reader, std::move(columns), "demand profile");
+    for (int step = 0; step < profile.getNumberOfSteps(); step++) {
+        for (int c = 0; c < profile.getNumberOfColumns(); c++) {
+            if (profile.getValue(step, c) < 0) {
+                cerr << "Error: Negative demand in the step " << profile.getLabel(step) << " of the demand profile." << endl;
+                exit(EXIT_FAILURE);
             }
         }
-        if (row.empty()) {
-            continue;
+    }
+    return profile;
+}
+
+ReservoirStorage Manager::importReservoirStorage(const string& path) const {
+    ReservoirStorage storage;
+    CsvReader reader(path);
+    vector<string> row;
+    while (reader.readRow(row)) {
+        const auto it = reservoirs.find(row[0]);
+        if (row.size() < 3 || it == reservoirs.end() || it->first == "SR" || storage.getIndex(row[0]) >= 0) {
+            cerr << "Error: Invalid reservoir " << row[0] << " in the storage file." << endl;
+            exit(EXIT_FAILURE);
         }
-        Vertex* station = new Station(stoi(row[0]),row[1]);
-        if (auto [_, success] = stations.insert({row[1],station});success) {
-            graph->addVertex(station);
+        const int volume = parseInt(row[1]);
+        const int capacity = parseInt(row[2]);
+        if (volume < 0 || volume > capacity) {
+            cerr << "Error: The volume of the reservoir " << row[0] << " is not between 0 and its capacity." << endl;
+            exit(EXIT_FAILURE);
         }
+        storage.add(static_cast<Reservoir*>(it->second), volume, capacity);
+    }
+    return storage;
+}
 
-
+TimeSeries Manager::importInflows(const string& path, const ReservoirStorage& storage) const {
+    CsvReader reader(path);
+    const vector<string>& header = reader.getHeader();
+    vector<int> columns;
+    for (size_t i = 1; i < header.size(); i++) {
+        const int reservoir = storage.getIndex(header[i]);
+        if (reservoir < 0) {
+            cerr << "Error: The reservoir " << header[i] << " of the inflows is not in the storage file." << endl;
+            exit(EXIT_FAILURE);
+        }
+        columns.push_back(reservoir);
     }
-    fin.close();
+    return importTimeSeries(reader, std::move(columns), "inflows");
 }
 
-void Manager::importPipes(const string& pathPipes) const {
-    fstream fin;
-    fin.open(pathPipes,ios::in);
-    if (!fin.is_open()) {
-        cerr << "Error: Unable to open file." << endl;
-        exit(EXIT_FAILURE);
+void Manager::simulateDemandProfile(const TimeSeries& profile, ostream& out) {
+    maxFlowBaseline();
+    FlowNetwork& network = bk.getNetwork();
+    const int n = cityTable.getNumberOfCities();
+    vector<int> sinkArcs(n);
+    vector<int> demands(cityTable.getDemands());
+    for (int i = 0; i < n; i++) {
+        sinkArcs[i] = network.getArc(cityTable.getSinkEdge(i));
     }
-    vector<string> row;
-    string line;
-    string word;
-    getline(fin,line);
-    while (getline(fin,line)) {
-        row.clear();
-        if (line.at(line.size()-1) == '\r') {
-            line = line.substr(0,line.size()-1);
-        }
-        stringstream ss(line);
-        while(getline(ss,word,',')){
-            if (!word.empty()) {
-                row.push_back(word);
+
+    out << "Step,Demand,Flow,Deficit";
+    for (int i = 0; i < n; i++) {
+        out << "," << cityTable.getCode(i);
+    }
+    out << '\n';
+
+    vector<long long> deficits(n);
+    for (int step = 0; step < profile.getNumberOfSteps(); step++) {
+        Tracer::Scope scope("demand step", profile.getLabel(step));
+        for (int c = 0; c < profile.getNumberOfColumns(); c++) {
+            const int city = profile.getColumn(c);
+            const int demand = profile.getValue(step, c);
+            if (demand != demands[city]) {
+                demands[city] = demand;
+                network.setBaseCapacity(sinkArcs[city], demand);
             }
         }
+        const long long flow = bk.solve();
 
-        Vertex* orig = findVertexInMap(row[0]);
-        Vertex* dest = findVertexInMap(row[1]);
-
-        if (stoi(row[3]) == 0) {
-            graph->addEdge(orig,dest,stoi(row[2]),"normal");
+        long long totalDemand = 0, totalDeficit = 0;
+        for (int i = 0; i < n; i++) {
+            deficits[i] = demands[i] - network.getFlow(sinkArcs[i]);
+            totalDemand += demands[i];
+            totalDeficit += deficits[i];
         }
-        else if (stoi(row[3]) == 1) {
-            Edge* e1 = graph->addEdge(orig,dest,stoi(row[2]),"normal");
-            Edge* e2 = graph->addEdge(dest,orig,stoi(row[2]),"normal");
-            e1->setReverseEdge(e2);
-            e2->setReverseEdge(e1);
+        out << profile.getLabel(step) << "," << totalDemand << "," << flow << "," << totalDeficit;
+        for (int i = 0; i < n; i++) {
+            out << "," << deficits[i];
         }
-        else {
-            cerr << "This value is not accepted for direction of edges" << endl;
-            exit(EXIT_FAILURE);
+        out << '\n';
+    }
+
+    // The next solve repairs the baseline flow back to the demands of the city table
+    for (int i = 0; i < n; i++) {
+        if (demands[i] != cityTable.getDemand(i)) {
+            network.setBaseCapacity(sinkArcs[i], cityTable.getDemand(i));
+        }
+    }
+    out.flush();
+}
+
+void Manager::simulateStorage(ReservoirStorage& storage, const vector<string>& scenarios, ostream& out) {
+    maxFlowBaseline();
+    FlowNetwork& network = bk.getNetwork();
+    const int n = storage.getNumberOfReservoirs();
+    vector<int> sourceArcs(n, -1);
+    for (const auto e : findVertexInMap("SR")->getAdj()) {
+        const int reservoir = storage.getIndex(Graph::getCode(e->getDest()));
+        if (reservoir >= 0) sourceArcs[reservoir] = network.getArc(e);
+    }
+    long long totalDemand = 0;
+    for (const int demand : cityTable.getDemands()) {
+        totalDemand += demand;
+    }
+
+    out << "Scenario,Step,Demand,Flow,Deficit";
+    for (int r = 0; r < n; r++) {
+        out << "," << storage.getCode(r);
+    }
+    out << '\n';
+
+    vector<long long> inflows(n);
+    for (const string& scenario : scenarios) {
+        // Each scenario repairs the flow left by the previous one
+        Tracer::Scope scope("scenario", scenario);
+        const TimeSeries series = importInflows(scenario, storage);
+        storage.restore();
+        for (int step = 0; step < series.getNumberOfSteps(); step++) {
+            Tracer::Scope stepScope("storage step", series.getLabel(step));
+            fill(inflows.begin(), inflows.end(), 0);
+            for (int c = 0; c < series.getNumberOfColumns(); c++) {
+                inflows[series.getColumn(c)] = series.getValue(step, c);
+            }
+            for (int r = 0; r < n; r++) {
+                const long long available = storage.getAvailable(r, inflows[r]);
+                if (available != network.getBaseCapacity(sourceArcs[r])) {
+                    network.setBaseCapacity(sourceArcs[r], available);
+                }
+            }
+            const long long flow = bk.solve();
+
+            out << scenario << "," << series.getLabel(step) << "," << totalDemand << "," << flow << "," << totalDemand - flow;
+            for (int r = 0; r < n; r++) {
+                storage.update(r, inflows[r], network.getFlow(sourceArcs[r]));
+                out << "," << storage.getVolume(r);
+            }
+            out << '\n';
         }
+    }
 
+    // The next solve repairs the baseline flow back to the max deliveries of the reservoirs
+    for (int r = 0; r < n; r++) {
+        const int maxDelivery = storage.getReservoir(r)->getMaxDelivery();
+        if (network.getBaseCapacity(sourceArcs[r]) != maxDelivery) {
+            network.setBaseCapacity(sourceArcs[r], maxDelivery);
+        }
     }
-    fin.close();
+    out.flush();
 }
+
 /*-----------------Max Flow Algorithms---------------------- */
 
 Vertex* Manager::addSuperSource() {
+    Tracer::Scope scope("add super source");
     Vertex* superSource = new Reservoir("Super Reservoir","_",-1,"SR",-1);
     graph->addVertex(superSource);
     reservoirs.insert({"SR",superSource});
@@ -416,15 +745,13 @@ Vertex* Manager::addSuperSource() {
 }
 
 Vertex* Manager::addSuperSink() {
+    Tracer::Scope scope("add super sink");
     Vertex* superSink = new City("Super Sink",-1,"SS",INT_MAX,-1);
     graph->addVertex(superSink);
     cities.insert({"SS",superSink});
 
-    for (const auto v : graph->getVertexSet()) {
-        if (v->getType() == 'C'  && dynamic_cast<City*>(v)->getCode() != "SS") {
-            const auto city = dynamic_cast<City*>(v);
-            graph->addEdge(v,superSink,city->getDemand(),"residual");
-        }
+    for (int i = 0; i < cityTable.getNumberOfCities(); i++) {
+        cityTable.setSinkEdge(i, graph->addEdge(cityTable.getCity(i),superSink,cityTable.getDemand(i),"residual"));
     }
     return superSink;
 }
@@ -450,18 +777,21 @@ vector<Edge*> Manager::dfs_flow(Vertex *superSource, Vertex *superSink) {
     }
 
     vector<Edge*> path;
+    SOLVER_COUNT(counters.searches++);
     dfs_helper(superSource, superSink, path);
     return path;
 }
 
 bool Manager::dfs_helper(Vertex *currentVertex, Vertex *superSink, vector<Edge*> &path) {
     currentVertex->setVisited(true);
+    SOLVER_COUNT(counters.verticesScanned++);
 
     if (currentVertex == superSink) {
         return true;
     }
 
     for (const auto e : currentVertex->getAdj()) {
+        SOLVER_COUNT(counters.edgesScanned++);
         if (Vertex* dest = e->getDest(); !dest->isVisited() && dest->isEnabled() && e->isEnabled() && e->getFlow() > 0) {
             dest->setPath(e);
             if (dfs_helper(dest, superSink, path)) {
@@ -488,11 +818,14 @@ vector<Edge*> Manager::bfs_flow(Vertex* superSource, Vertex* superSink) {
     queue<Vertex*> q;
     q.push(superSource);
     superSource->setVisited(true);
+    SOLVER_COUNT(counters.searches++);
 
     while(!q.empty()) {
         const auto v = q.front();
         q.pop();
+        SOLVER_COUNT(counters.verticesScanned++);
         for (const auto e : v->getAdj()) {
+            SOLVER_COUNT(counters.edgesScanned++);
             if(const auto dest = e->getDest();e->getOrigin()->isEnabled() && !dest->isVisited() && dest->isEnabled() && e->isEnabled()  && (e->getFlow() > 0)) {
                 q.push(dest);
                 dest->setVisited(true);
@@ -512,25 +845,37 @@ vector<Edge*> Manager::bfs_flow(Vertex* superSource, Vertex* superSink) {
     return path;
 }
 
-vector<pair<string,int>> Manager::maxFlow(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*)) {
-    Vertex* superSource = addSuperSource();
-    Vertex* superSink = addSuperSink();
-
+void Manager::initializeFlows() {
     for (const auto v: graph->getVertexSet()) {
         for (const auto e : v->getAdj()) {
             e->setFlow(e->getCapacity());
         }
     }
+}
 
+vector<pair<string,int>> Manager::maxFlow(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*)) {
+    Tracer::Scope scope(explore_paths == &Manager::bfs_flow ? "max flow edmonds-karp" : "max flow ford-fulkerson");
+    Vertex* superSource = addSuperSource();
+    Vertex* superSink = addSuperSink();
+    initializeFlows();
+    augmentFlows(explore_paths, superSource, superSink);
+    return getCityFlows();
+}
+
+void Manager::augmentFlows(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*), Vertex* superSource, Vertex* superSink) {
     vector<Edge*> path;
     while(!(path = (this->*explore_paths)(superSource, superSink)).empty()) {
         const int newFlow = findMinEdge(path);
+        SOLVER_COUNT(counters.augmentingPaths++);
+        SOLVER_COUNT(counters.pathEdges += path.size());
+        SOLVER_COUNT(counters.longestPath = max(counters.longestPath, static_cast<long long>(path.size())));
         for (const auto e: path) {
             if (e->getReverseEdge() == nullptr) {
                 const auto edg = graph->addEdge(e->getDest(), e->getOrigin(), e->getCapacity(), "residual");
                 edg->setFlow(0);
                 edg->setReverseEdge(e);
                 e->setReverseEdge(edg);
+                SOLVER_COUNT(counters.residualEdges++);
             }
             e->setFlow(e->getFlow() - newFlow);
             e->getReverseEdge()->setFlow(e->getReverseEdge()->getFlow() + newFlow);
@@ -538,17 +883,14 @@ vector<pair<string,int>> Manager::maxFlow(vector<Edge*> (Manager::*explore_paths
 
         path.clear();
     }
-    // Final Calculation of paths
+}
+
+vector<pair<string,int>> Manager::getCityFlows() const {
+    const vector<int> supplied = cityTable.getSupplied();
     vector<pair<string,int>> result;
-    for (const auto n : graph->getVertexSet()) {
-        if (n->getType() == 'C' && Graph::getCode(n) != "SS") {
-            int sumFlow = 0;
-            for (const auto e : n->getIncoming()) {
-                if (e->getType() == "residual")
-                    sumFlow+= e->getFlow();
-            }
-            result.push_back(make_pair(Graph::getCode(n), sumFlow));
-        }
+    result.reserve(supplied.size());
+    for (int i = 0; i < cityTable.getNumberOfCities(); i++) {
+        result.push_back(make_pair(cityTable.getCode(i), supplied[i]));
     }
     return result;
 }
@@ -560,6 +902,406 @@ vector<pair<string,int>> Manager::maxFlowEdmondsKarp() {
 vector<pair<string,int>> Manager::maxFlowFordFulkerson() {
     return maxFlow(&Manager::dfs_flow);
 }
+
+vector<pair<string,int>> Manager::getCityFlows(const FlowNetwork& network) const {
+    vector<pair<string,int>> result;
+    result.reserve(cityTable.getNumberOfCities());
+    for (int i = 0; i < cityTable.getNumberOfCities(); i++) {
+        const int a = network.getArc(cityTable.getSinkEdge(i));
+        result.push_back(make_pair(cityTable.getCode(i), a < 0 ? 0 : static_cast<int>(network.getFlow(a))));
+    }
+    return result;
+}
+
+vector<pair<string,int>> Manager::maxFlowBoykovKolmogorov() {
+    Tracer::Scope scope("max flow boykov-kolmogorov");
+    Vertex* superSource = addSuperSource();
+    Vertex* superSink = addSuperSink();
+    initializeFlows();
+
+    bk.build(graph, superSource, superSink);
+    bk.solve();
+    bk.getNetwork().writeFlows();
+    return getCityFlows(bk.getNetwork());
+}
+
+vector<pair<string,int>> Manager::solveBoykovKolmogorov() {
+    Tracer::Scope scope("repair boykov-kolmogorov");
+    bk.solve();
+    return getCityFlows(bk.getNetwork());
+}
+
+vector<pair<string,int>> Manager::maxFlowPushRelabel() {
+    Tracer::Scope scope("max flow push-relabel");
+    Vertex* superSource = addSuperSource();
+    Vertex* superSink = addSuperSink();
+    initializeFlows();
+
+    FlowNetwork network;
+    network.build(graph, superSource, superSink);
+    NetworkReduction reduction(network);
+    RegionSolver().solve(reduction.getReduced());
+    reduction.expand(network);
+    network.writeFlows();
+    return getCityFlows(network);
+}
+
+int Manager::getPipeFlow(const Edge* e, const Vertex* superSource, const Vertex* superSink) {
+    if (e->getType() != "normal" && e->getOrigin() != superSource && e->getDest() != superSink) {
+        return 0;
+    }
+    return e->getCapacity() - e->getFlow();
+}
+
+vector<vector<pair<int,int>>> Manager::getFlowAdjacency(const vector<Vertex*>& vertexes, unordered_map<const Vertex*,int>& index) const {
+    Vertex* superSource = findVertexInMap("SR");
+    Vertex* superSink = findVertexInMap("SS");
+    const int n = static_cast<int>(vertexes.size());
+    index.clear();
+    index.reserve(n);
+    for (int i = 0; i < n; i++) {
+        index[vertexes[i]] = i;
+    }
+
+    vector<vector<pair<int,int>>> flows(n);
+    for (int i = 0; i < n; i++) {
+        for (const auto e : vertexes[i]->getAdj()) {
+            const int flow = getPipeFlow(e, superSource, superSink);
+            if (flow > 0) {
+                flows[i].push_back(make_pair(index[e->getDest()], flow));
+            }
+        }
+    }
+    return flows;
+}
+
+vector<int> Manager::cancelFlowCycles(vector<vector<pair<int,int>>>& flows) {
+    const int n = static_cast<int>(flows.size());
+    vector<int> state(n, 0); // 0 not visited, 1 in the stack, 2 finished
+    vector<size_t> current(n, 0); // Next edge of each vertex to explore
+    vector<int*> parentFlow(n, nullptr); // Flow of the edge each vertex in the stack was reached by
+    vector<int> stack;
+    vector<int> finished;
+    finished.reserve(n);
+    // Vertexes taken out of the stack after a cycle are explored again later
+    vector<int> roots(n);
+    iota(roots.begin(), roots.end(), 0);
+
+    for (size_t r = 0; r < roots.size(); r++) {
+        const int root = roots[r];
+        if (state[root] != 0) continue;
+        state[root] = 1;
+        stack.push_back(root);
+        while (!stack.empty()) {
+            const int v = stack.back();
+            auto& edges = flows[v];
+            size_t& i = current[v];
+            while (i < edges.size() && (edges[i].second == 0 || state[edges[i].first] == 2)) i++;
+            if (i == edges.size()) {
+                state[v] = 2;
+                finished.push_back(v);
+                stack.pop_back();
+                continue;
+            }
+
+            const int w = edges[i].first;
+            if (state[w] == 0) {
+                state[w] = 1;
+                parentFlow[w] = &edges[i].second;
+                stack.push_back(w);
+                continue;
+            }
+
+            // The edge closes a cycle with the stack, cancel its smallest flow and go back to w
+            int amount = edges[i].second;
+            for (size_t k = stack.size() - 1; stack[k] != w; k--) {
+                amount = min(amount, *parentFlow[stack[k]]);
+            }
+            edges[i].second -= amount;
+            while (stack.back() != w) {
+                *parentFlow[stack.back()] -= amount;
+                state[stack.back()] = 0;
+                roots.push_back(stack.back());
+                stack.pop_back();
+            }
+        }
+    }
+
+    // Every edge with flow goes to a vertex that finished before its origin
+    reverse(finished.begin(), finished.end());
+    return finished;
+}
+
+FlowDecomposition Manager::decomposeFlow() const {
+    Vertex* superSource = findVertexInMap("SR");
+    Vertex* superSink = findVertexInMap("SS");
+    FlowDecomposition decomposition;
+    if (superSource == nullptr || superSink == nullptr) return decomposition;
+
+    // Flow of every edge that is not in a path yet
+    const vector<Vertex*> vertexes = graph->getVertexSet();
+    const int n = static_cast<int>(vertexes.size());
+    unordered_map<const Vertex*, int> index;
+    vector<vector<pair<int,int>>> remaining = getFlowAdjacency(vertexes, index);
+
+    const int source = index[superSource];
+    const int sink = index[superSink];
+    vector<size_t> current(n, 0); // First edge of each vertex that may still have flow
+    vector<int> position(n, -1); // Position of each vertex in the walk
+    vector<int> walk;
+    vector<int*> walkFlows;
+    vector<Vertex*> path;
+    while (true) {
+        walk.assign(1, source);
+        walkFlows.clear();
+        position[source] = 0;
+        int v = source;
+        while (v != sink) {
+            auto& edges = remaining[v];
+            size_t& i = current[v];
+            while (i < edges.size() && edges[i].second == 0) i++;
+            if (i == edges.size()) break;
+
+            const int w = edges[i].first;
+            walkFlows.push_back(&edges[i].second);
+            if (position[w] < 0) {
+                position[w] = static_cast<int>(walk.size());
+                walk.push_back(w);
+                v = w;
+                continue;
+            }
+
+            // The walk closed a cycle, its flow doesn't reach any city so it is cancelled
+            const int start = position[w];
+            int amount = INT_MAX;
+            for (size_t k = start; k < walkFlows.size(); k++) {
+                amount = min(amount, *walkFlows[k]);
+            }
+            for (size_t k = start; k < walkFlows.size(); k++) {
+                *walkFlows[k] -= amount;
+            }
+            for (size_t k = start + 1; k < walk.size(); k++) {
+                position[walk[k]] = -1;
+            }
+            walk.resize(start + 1);
+            walkFlows.resize(start);
+            v = w;
+        }
+        for (const int u : walk) {
+            position[u] = -1;
+        }
+        // Only the super source runs out of flow in a valid flow, so every path was found
+        if (v != sink) break;
+
+        int amount = INT_MAX;
+        for (const int* flow : walkFlows) {
+            amount = min(amount, *flow);
+        }
+        for (int* flow : walkFlows) {
+            *flow -= amount;
+        }
+        path.clear();
+        for (size_t k = 1; k + 1 < walk.size(); k++) {
+            path.push_back(vertexes[walk[k]]);
+        }
+        decomposition.addPath(path, amount);
+    }
+    return decomposition;
+}
+
+AttributionMatrix Manager::attributeFlow() const {
+    Vertex* superSource = findVertexInMap("SR");
+    Vertex* superSink = findVertexInMap("SS");
+    const vector<Vertex*> vertexes = graph->getVertexSet();
+    vector<Vertex*> reservoirVertexes;
+    vector<Vertex*> cityVertexes;
+    for (const auto v : vertexes) {
+        if (v->getType() == 'R' && v != superSource) reservoirVertexes.push_back(v);
+        if (v->getType() == 'C' && v != superSink) cityVertexes.push_back(v);
+    }
+    AttributionMatrix matrix(reservoirVertexes, cityVertexes);
+    if (superSource == nullptr || superSink == nullptr) return matrix;
+
+    unordered_map<const Vertex*, int> index;
+    vector<vector<pair<int,int>>> flows = getFlowAdjacency(vertexes, index);
+    const vector<int> order = cancelFlowCycles(flows);
+    const int source = index[superSource];
+    const int sink = index[superSink];
+
+    // Flow that arrives at each vertex from each reservoir, (row of the reservoir, flow) possibly repeated
+    vector<vector<pair<int,double>>> arriving(vertexes.size());
+    for (const auto& edge : flows[source]) {
+        arriving[edge.first].push_back(make_pair(matrix.getReservoirIndex(vertexes[edge.first]), static_cast<double>(edge.second)));
+    }
+
+    // In topological order the flow that arrives at a vertex is known before it leaves, and it leaves through each edge in proportion to the flow of the edge
+    for (const int v : order) {
+        if (v == source || v == sink || arriving[v].empty()) continue;
+        auto& parts = arriving[v];
+        sort(parts.begin(), parts.end());
+        size_t size = 0;
+        double total = 0;
+        for (size_t k = 0; k < parts.size(); k++) {
+            if (size > 0 && parts[size - 1].first == parts[k].first) parts[size - 1].second += parts[k].second;
+            else parts[size++] = parts[k];
+            total += parts[k].second;
+        }
+        parts.resize(size);
+
+        const int city = matrix.getCityIndex(vertexes[v]);
+        for (const auto& edge : flows[v]) {
+            if (edge.second == 0) continue;
+            const double fraction = edge.second / total;
+            for (const auto& part : parts) {
+                if (edge.first == sink) matrix.add(part.first, city, part.second * fraction);
+                else arriving[edge.first].push_back(make_pair(part.first, part.second * fraction));
+            }
+        }
+        vector<pair<int,double>>().swap(parts);
+    }
+    return matrix;
+}
+
+void Manager::cancelFlow(Edge* e, const int amount) {
+    e->setFlow(e->getFlow() + amount);
+    e->getReverseEdge()->setFlow(e->getReverseEdge()->getFlow() - amount);
+}
+
+void Manager::removeFlow(const vector<Vertex*>& vertexes, const vector<Edge*>& pipes) {
+    Vertex* superSource = findVertexInMap("SR");
+    Vertex* superSink = findVertexInMap("SS");
+
+    // Flow that arrives at a vertex and doesn't leave it is positive, flow that leaves and doesn't arrive is negative
+    unordered_map<Vertex*,int> imbalance;
+    auto cancel = [&](Edge* e) {
+        const int flow = getPipeFlow(e, superSource, superSink);
+        if (flow <= 0) return;
+        cancelFlow(e, flow);
+        imbalance[e->getOrigin()] += flow;
+        imbalance[e->getDest()] -= flow;
+    };
+    for (const auto v : vertexes) {
+        for (const auto e : v->getAdj()) cancel(e);
+        for (const auto e : v->getIncoming()) cancel(e);
+    }
+    for (const auto p : pipes) {
+        cancel(p);
+        if (p->getReverseEdge() != nullptr) cancel(p->getReverseEdge());
+    }
+
+    // Walk the imbalances along the flow paths, back to the super source and forward to the super sink
+    vector<Vertex*> unbalanced;
+    for (const auto& [v, balance] : imbalance) {
+        if (balance != 0) unbalanced.push_back(v);
+    }
+    while (!unbalanced.empty()) {
+        Vertex* v = unbalanced.back();
+        unbalanced.pop_back();
+        if (v == superSource || v == superSink) continue;
+
+        int balance = imbalance[v];
+        if (balance > 0) {
+            for (const auto e : v->getIncoming()) {
+                if (balance == 0) break;
+                const int d = min(balance, getPipeFlow(e, superSource, superSink));
+                if (d <= 0) continue;
+                cancelFlow(e, d);
+                balance -= d;
+                imbalance[e->getOrigin()] += d;
+                unbalanced.push_back(e->getOrigin());
+            }
+        }
+        else if (balance < 0) {
+            for (const auto e : v->getAdj()) {
+                if (balance == 0) break;
+                const int d = min(-balance, getPipeFlow(e, superSource, superSink));
+                if (d <= 0) continue;
+                cancelFlow(e, d);
+                balance += d;
+                imbalance[e->getDest()] -= d;
+                unbalanced.push_back(e->getDest());
+            }
+        }
+        imbalance[v] = balance;
+    }
+}
+
+/**
+ * @brief Gets the code of a failure scenario, joining the codes of the elements disabled with '+'.
+ * @param codes The codes of the reservoirs or stations disabled.
+ * @return The code of the scenario.
+ */
+static string getScenarioCode(const vector<string>& codes) {
+    string scenario;
+    for (const string& code : codes) {
+        if (!scenario.empty()) scenario += '+';
+        scenario += code;
+    }
+    return scenario;
+}
+
+/**
+ * @brief Gets the code of a failure scenario, joining the pipes disabled, as origin-destination, with '+'.
+ * @param pipes The pipes disabled.
+ * @return The code of the scenario.
+ */
+static string getScenarioCode(const vector<Edge*>& pipes) {
+    string scenario;
+    for (const Edge* pipe : pipes) {
+        if (!scenario.empty()) scenario += '+';
+        scenario += Graph::getCode(pipe->getOrigin()) + "-" + Graph::getCode(pipe->getDest());
+    }
+    return scenario;
+}
+
+vector<pair<string,int>> Manager::repairMaxFlow(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*), const vector<string>& codes, const vector<Edge*>& pipes) {
+    Tracer::Scope scope("repair max flow");
+    vector<Vertex*> vertexes;
+    for (const auto& code : codes) {
+        vertexes.push_back(findVertexInMap(code));
+    }
+    removeFlow(vertexes, pipes);
+    augmentFlows(explore_paths, findVertexInMap("SR"), findVertexInMap("SS"));
+    auto flows = getCityFlows();
+    if (verifyRepairs && !isMaxFlow(flows)) {
+        cerr << "Warning: The repaired flow without " << (codes.empty() ? getScenarioCode(pipes) : getScenarioCode(codes)) << " is not a maximum flow" << endl;
+        repairMismatches++;
+    }
+    return flows;
+}
+
+void Manager::restoreMaxFlow(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*)) {
+    Tracer::Scope scope("restore max flow");
+    augmentFlows(explore_paths, findVertexInMap("SR"), findVertexInMap("SS"));
+}
+
+bool Manager::isMaxFlow(const vector<pair<string,int>>& flows) const {
+    long long total = 0;
+    for (const auto& flow : flows)
+        total += flow.second;
+
+    // Copy the enabled pipes, without flow, to a network of their own
+    Vertex* superSource = findVertexInMap("SR");
+    Vertex* superSink = findVertexInMap("SS");
+    const vector<Vertex*>& vertexes = graph->getVertexSet();
+    unordered_map<const Vertex*,int> index;
+    index.reserve(vertexes.size());
+    for (size_t i = 0; i < vertexes.size(); i++) {
+        index[vertexes[i]] = static_cast<int>(i);
+    }
+    vector<FlowNetwork::Pipe> pipes;
+    for (const auto v : vertexes) {
+        for (const auto e : v->getAdj()) {
+            if (e->getType() != "normal" && e->getOrigin() != superSource && e->getDest() != superSink) continue;
+            if (!e->isEnabled() || !e->getOrigin()->isEnabled() || !e->getDest()->isEnabled()) continue;
+            pipes.push_back({index[e->getOrigin()], index[e->getDest()], e->getCapacity(), 0});
+        }
+    }
+    FlowNetwork network;
+    vector<int> pipeArcs;
+    network.build(static_cast<int>(vertexes.size()), index[superSource], index[superSink], pipes, pipeArcs);
+    return PushRelabel(1).solve(network) == total;
+}
 /*---------------------Exercise 2.1 -----------------------*/
 
 void Manager::printFlowMetrics(vector<pair<string, int>>& flows,vector<string>& chosenCities, const string& outputFile) {
@@ -581,13 +1323,19 @@ void Manager::printFlowMetrics(vector<pair<string, int>>& flows,vector<string>&
 
 void Manager::getEdmondsKarpXCity(vector<string>& cities) {
     auto flows = maxFlowEdmondsKarp();
-    printFlowMetrics(flows, cities, "../data/results/results_21_EK.csv");
+    printFlowMetrics(flows, cities, resultWriter.getPath("21_EK"));
     resetGraph();
 }
 
 void Manager::getFordFulkersonXCity(vector<string>& cities) {
     auto flows = maxFlowFordFulkerson();
-    printFlowMetrics(flows, cities, "../data/results/results_21_FF.csv");
+    printFlowMetrics(flows, cities, resultWriter.getPath("21_FF"));
+    resetGraph();
+}
+
+void Manager::getPushRelabelXCity(vector<string>& cities) {
+    auto flows = maxFlowPushRelabel();
+    printFlowMetrics(flows, cities, resultWriter.getPath("21_PR"));
     resetGraph();
 }
 
@@ -599,7 +1347,7 @@ void Manager::getEdmondsKarpAllCities(bool reset) {
         cities.push_back(flow.first);
     }
     if(reset) {
-        printFlowMetrics(flows, cities, "../data/results/results_21_EK.csv");
+        printFlowMetrics(flows, cities, resultWriter.getPath("21_EK"));
         resetGraph();
     }
 
@@ -612,7 +1360,19 @@ void Manager::getFordFulkersonAllCities(bool reset) {
         cities.push_back(flow.first);
     }
     if(reset) {
-        printFlowMetrics(flows, cities, "../data/results/results_21_FF.csv");
+        printFlowMetrics(flows, cities, resultWriter.getPath("21_FF"));
+        resetGraph();
+    }
+}
+
+void Manager::getPushRelabelAllCities(bool reset) {
+    auto flows = maxFlowPushRelabel();
+    vector<string> cities;
+    for (auto flow: flows) {
+        cities.push_back(flow.first);
+    }
+    if(reset) {
+        printFlowMetrics(flows, cities, resultWriter.getPath("21_PR"));
         resetGraph();
     }
 }
@@ -620,388 +1380,343 @@ void Manager::getFordFulkersonAllCities(bool reset) {
 
 /*---------------------Exercise 2.2 -----------------------*/
 
-vector<pair<string,bool>> Manager::canCityGetEnoughWater(vector<string>& codes,vector<pair<string,int>>& flows) {
+vector<pair<string,bool>> Manager::canCityGetEnoughWater(const vector<string>& codes, const vector<int>& supplied) const {
+    vector<unsigned char> selected(cityTable.getNumberOfCities(), 0);
+    for (const auto& code : codes) {
+        const int i = cityTable.getIndex(code);
+        if (i >= 0) selected[i] = 1;
+    }
+    vector<int> deficits;
+    vector<unsigned char> satisfied;
+    cityTable.computeDeficits(supplied, deficits, satisfied);
+
     vector<pair<string,bool>> results;
-    for (const auto& flow : flows) {
-        if (find(codes.begin(),codes.end(),flow.first) != codes.end()) {
-            int demand = dynamic_cast<City*>(findVertexInMap(flow.first))->getDemand();
-            if (demand > flow.second) {
-                int deficit = demand - flow.second;
-                cout << ANSI_COLOR_RED << "The city with code " << flow.first << " can't get enough flow. flow : " << flow.second << " demand: " << demand << " deficit: " << deficit << ANSI_COLOR_RESET << endl;
-                results.push_back(make_pair(flow.first,false));
+    long long totalDeficit = 0;
+    for (int i = 0; i < cityTable.getNumberOfCities(); i++) {
+        if (!selected[i]) continue;
+        if (!satisfied[i]) {
+            cout << ANSI_COLOR_RED << "The city with code " << cityTable.getCode(i) << " can't get enough flow. flow : " << supplied[i] << " demand: " << cityTable.getDemand(i) << " deficit: " << deficits[i] << ANSI_COLOR_RESET << "\n";
+        }
+        else {
+            cout << "The city with code " << cityTable.getCode(i) << " can get enough flow. flow : " << supplied[i] << " demand: " << cityTable.getDemand(i) << "\n";
+        }
+        totalDeficit += deficits[i];
+        results.push_back(make_pair(cityTable.getCode(i), satisfied[i] != 0));
+    }
+    cout << "The total deficit is: " << totalDeficit << endl;
+    return results;
+}
+
+MinCut Manager::getMinCut() {
+    MinCut cut;
+    Vertex* superSource = findVertexInMap("SR");
+    Vertex* superSink = findVertexInMap("SS");
+    if (superSource == nullptr || superSink == nullptr) return cut;
+
+    // The source side of the cut is what the super source reaches in the residual graph
+    for (const auto v : graph->getVertexSet()) {
+        v->setVisited(false);
+    }
+    queue<Vertex*> q;
+    q.push(superSource);
+    superSource->setVisited(true);
+    while (!q.empty()) {
+        const auto v = q.front();
+        q.pop();
+        for (const auto e : v->getAdj()) {
+            if (const auto dest = e->getDest(); e->getOrigin()->isEnabled() && !dest->isVisited() && dest->isEnabled() && e->isEnabled() && e->getFlow() > 0) {
+                dest->setVisited(true);
+                q.push(dest);
+            }
+        }
+    }
+
+    const vector<int> supplied = cityTable.getSupplied();
+    vector<int> deficits;
+    vector<unsigned char> satisfied;
+    cityTable.computeDeficits(supplied, deficits, satisfied);
+    const FlowDecomposition decomposition = decomposeFlow();
+
+    for (const auto v : graph->getVertexSet()) {
+        if (!v->isVisited()) continue;
+        for (const auto e : v->getAdj()) {
+            Vertex* dest = e->getDest();
+            if (dest->isVisited() || dest == superSink || (e->getType() != "normal" && v != superSource)) continue;
+            if (!e->isEnabled() || !dest->isEnabled() || e->getCapacity() == 0) continue;
+
+            // The cities behind the pipe are the ones whose water crosses it, the super source is internal so its
+            // edges are the max delivery of their reservoir
+            MinCut::Pipe pipe;
+            vector<int> paths;
+            if (v == superSource) {
+                pipe = {Graph::getCode(dest), "(max delivery)", e->getCapacity(), {}};
+                for (int p = 0; p < decomposition.getNumberOfPaths(); p++) {
+                    if (decomposition.getReservoir(p) == dest) paths.push_back(p);
+                }
             }
             else {
-                cout << "The city with code " << flow.first << " can get enough flow. flow : " << flow.second << " demand: " << demand << endl;
-                results.push_back(make_pair(flow.first,true));
+                pipe = {Graph::getCode(v), Graph::getCode(dest), e->getCapacity(), {}};
+                paths = decomposition.getPathsThrough(e);
+            }
+            unordered_set<const Vertex*> behind;
+            for (const int p : paths) {
+                if (!behind.insert(decomposition.getCity(p)).second) continue;
+                const int i = cityTable.getIndex(Graph::getCode(decomposition.getCity(p)));
+                pipe.cities.emplace_back(cityTable.getCode(i), deficits[i]);
             }
+            cut.pipes.push_back(std::move(pipe));
+        }
+    }
+    return cut;
+}
+
+void Manager::writeMinCut(ostream& out, const MinCut& cut) {
+    out << "Origin,Destination,Capacity,City,Deficit" << '\n';
+    for (const auto& pipe : cut.pipes) {
+        if (pipe.cities.empty()) {
+            out << pipe.origin << "," << pipe.destination << "," << pipe.capacity << ",," << '\n';
+        }
+        for (const auto& [city, deficit] : pipe.cities) {
+            out << pipe.origin << "," << pipe.destination << "," << pipe.capacity << "," << city << "," << deficit << '\n';
         }
     }
-    return results;
+}
+
+void Manager::printMinCut(const MinCut& cut, const string& outputFile) {
+    cout << "The minimum cut has " << cut.pipes.size() << " saturated pipes with a total capacity of " << cut.getCapacity() << ":" << "\n";
+    for (const auto& pipe : cut.pipes) {
+        cout << "Pipe " << pipe.origin << " -> " << pipe.destination << " with capacity " << pipe.capacity;
+        cout << (pipe.cities.empty() ? " reaches no city" : " reaches");
+        for (size_t i = 0; i < pipe.cities.size(); i++) {
+            cout << (i == 0 ? " " : ", ") << pipe.cities[i].first;
+            if (pipe.cities[i].second > 0) cout << " (deficit " << pipe.cities[i].second << ")";
+        }
+        cout << "\n";
+    }
+    cout.flush();
+    createCsvFileMinCut(outputFile, cut);
 }
 
 void Manager::canCityXGetEnoughWaterEK(vector<string>& cities) {
-    auto flows = maxFlowEdmondsKarp();
-    auto results = canCityGetEnoughWater(cities,flows);
+    maxFlowEdmondsKarp();
+    auto results = canCityGetEnoughWater(cities,cityTable.getSupplied());
 
-    string path = "../data/results/results_cityXEnoughWaterEK.csv";
+    string path = resultWriter.getPath("cityXEnoughWaterEK");
     createCsvFileEnoughWater(path,results);
+    printMinCut(getMinCut(), resultWriter.getPath("minCutEK"));
     resetGraph();
 }
 
 void Manager::canCityXGetEnoughWaterFF(vector<string>& cities) {
-    auto flows = maxFlowFordFulkerson();
-    auto results = canCityGetEnoughWater(cities,flows);
-    string path = "../data/results/results_cityXEnoughWaterFF.csv";
+    maxFlowFordFulkerson();
+    auto results = canCityGetEnoughWater(cities,cityTable.getSupplied());
+    string path = resultWriter.getPath("cityXEnoughWaterFF");
     createCsvFileEnoughWater(path,results);
+    printMinCut(getMinCut(), resultWriter.getPath("minCutFF"));
     resetGraph();
 }
 
 void Manager::canAllCitiesGetEnoughWaterEK() {
-    auto flows = maxFlowEdmondsKarp();
+    maxFlowEdmondsKarp();
     vector<string> cities;
-    for (auto n : getCities()) {
-        cities.push_back(n.first);
+    for (int i = 0; i < cityTable.getNumberOfCities(); i++) {
+        cities.push_back(cityTable.getCode(i));
     }
-    auto results = canCityGetEnoughWater(cities,flows);
-    string path = "../data/results/results_allCitiesEnoughWaterEK.csv";
+    auto results = canCityGetEnoughWater(cities,cityTable.getSupplied());
+    string path = resultWriter.getPath("allCitiesEnoughWaterEK");
     createCsvFileEnoughWater(path,results);
+    printMinCut(getMinCut(), resultWriter.getPath("minCutEK"));
     resetGraph();
 }
 
 void Manager::canAllCitiesGetEnoughWaterFF() {
-    auto flows = maxFlowFordFulkerson();
+    maxFlowFordFulkerson();
     vector<string> cities;
-    for (auto n : getCities()) {
-        cities.push_back(n.first);
+    for (int i = 0; i < cityTable.getNumberOfCities(); i++) {
+        cities.push_back(cityTable.getCode(i));
     }
-    auto results = canCityGetEnoughWater(cities,flows);
-    string path = "../data/results/results_allCitiesEnoughWaterFF.csv";
+    auto results = canCityGetEnoughWater(cities,cityTable.getSupplied());
+    string path = resultWriter.getPath("allCitiesEnoughWaterFF");
     createCsvFileEnoughWater(path,results);
+    printMinCut(getMinCut(), resultWriter.getPath("minCutFF"));
     resetGraph();
 }
 
 /* -------------------Exercise 2.3----------------------------- */
 
-void Manager::improvePipesHeuristic() {
-
-    vector<int> control_metrics = getMetrics();
-
-    int ctrl = control_metrics.at(4);
-    int sum = 0;
-    bool check;
-
-    do{
-        check = true;
-
-        for(auto a: graph->getVertexSet()){
-
-            for(auto b: a->getAdj()){
-
-                int dif = b->getCapacity() - b->getFlow();
-
-                if(b->getCapacity() > ctrl) {
-
-                    if (dif < ctrl) {
-
-                        int val = ctrl - dif;
-
-                        sum += val;
-                        b->setFlow(b->getCapacity() - ctrl);
-                        check = false;
-                    }
-                    if (dif > ctrl) {
-
-                        int val = dif - ctrl;
-
-                        if(sum >= val) {
-                            b->setFlow(b->getFlow() + val);
-                            sum -= val;
-                        }
-                    }
-
-                }
-
-            }
+void Manager::improvePipesMinCost() {
 
-        }
-
-    }while(!check);
+    const FlowMetrics control_metrics = getMetrics();
+    int control_flow = 0;
+    for (const auto& flow : getCityFlows()) {
+        control_flow += flow.second;
+    }
 
-    vector<int> new_metrics = getMetrics();
+    // Solve again from scratch with the min-cost max-flow engine
+    resetGraph();
+    Vertex* superSource = addSuperSource();
+    Vertex* superSink = addSuperSink();
+    initializeFlows();
+    FlowNetwork network;
+    network.build(graph, superSource, superSink);
+    MinCostFlow balancer;
+    const long long new_flow = balancer.solve(network);
+    network.writeFlows();
 
-    cout << endl;
-    cout << "Control Metrics:" << endl;
-    cout << "Min Flow: " << control_metrics.at(0) << endl;
-    cout << "Max Flow: " << control_metrics.at(1) << endl;
-    cout << "Average Flow: " << control_metrics.at(2) << endl;
-    cout << "Max Difference between Flow and Capacity: " << control_metrics.at(3) << endl;
-    cout << "Average Difference between Flow and Capacity: " << control_metrics.at(4) << endl;
-    cout << "Variance of the difference between Flow and Capacity : " << control_metrics.at(5) << endl;
+    const FlowMetrics new_metrics = getMetrics();
 
-    cout << endl;
-    cout << "New Metrics:" << endl;
-    cout << "Min Flow: " << new_metrics.at(0) << endl;
-    cout << "Max Flow: " << new_metrics.at(1) << endl;
-    cout << "Average Flow: " << new_metrics.at(2) << endl;
-    cout << "Max Difference between Flow and Capacity: " << new_metrics.at(3) << endl;
-    cout << "Average Difference between Flow and Capacity: " << new_metrics.at(4) << endl;
-    cout << "Variance of the difference between Flow and Capacity : " << new_metrics.at(5) << endl;
+    printMetrics("Control Metrics", control_metrics);
+    cout << "Total Flow: " << control_flow << endl;
+    printMetrics("New Metrics", new_metrics);
+    cout << "Total Flow: " << new_flow << endl;
+    cout << "Cost of the balanced flow: " << balancer.getCost() << endl;
 
     resetGraph();
-
-    return;
 }
 
 /* -------------------Exercise 3.1----------------------------- */
 
-void Manager::disableReservoirs(vector<string> &reservoirs) {
-    for(string code : reservoirs) {
-        findVertexInMap(code)->setEnabled(false);
-    }
-}
-void Manager::dfs_disable(Vertex* vertex, int flowToRemove) {
-    if (Graph::getCode(vertex) == "SS") {
-        return;
-    }
-
-    for (auto e : vertex->getAdj()) {
-        if (flowToRemove == 0){
-            break;
+void Manager::printPipeDecline(const vector<pair<string,int>>& flows, const FlowDiff& diff) {
+    for (size_t i = 0; i < flows.size(); i++) {
+        if(diff.decline[i] == 0.0) {
+            cout << "City code: " << flows[i].first << ", Percentage Decline: " << diff.decline[i] << "%" << '\n';
         }
-        int delta = min(e->getCapacity()-e->getFlow(), flowToRemove);
-        if (delta <= 0) {
-            continue;
+        else {
+            cout << "City code: " << flows[i].first << ", Percentage Decline: -" << diff.decline[i] << "%" << '\n';
         }
-
-        e->getReverseEdge()->setFlow(e->getReverseEdge()->getFlow() - delta);
-        e->setFlow(e->getFlow() + delta);
-        flowToRemove -= delta;
-        dfs_disable(e->getDest(), delta);
     }
 }
 
-
-
-
-vector<pair<string,int>> Manager::graphChangeFlowsAfterReservoirsDisabled(vector<string> &reservoirs) {
-    // Find super reservoir
-    Vertex* super_reservoir = nullptr;
-    for (auto v : graph->getVertexSet()){
-        if(Graph::getCode(v) == "SR"){
-            super_reservoir = v;
-            break;
-        }
-    }
-
-    if(super_reservoir == nullptr){
-        cerr << "Error finding super reservoir" << endl;
-        exit(EXIT_FAILURE);
-    }
-
-
-    for (const auto& r : reservoirs) {
-        // Set flow as zero from super-reservoir to reservoir
-        for (auto v : graph->getVertexSet()){
-            v->setVisited(false);
-        }
-        Vertex* v = findVertexInMap(r);
-        int flowToRemove = 0;
-        for (auto e : super_reservoir->getAdj()){
-            if (Graph::getCode(e->getDest()) == Graph::getCode(v)) {
-                e->setFlow(e->getCapacity());
-                e->getReverseEdge()->setFlow(e->getCapacity());
-                flowToRemove = e->getFlow();
-                break;
-            }
-        }
-        // Disable reservoir
-        dfs_disable(v,flowToRemove);
-    }
-
-    // Calculate Results of flow.
-    vector<pair<string,int>> result;
-    for (const auto n : graph->getVertexSet()) {
-        if (n->getType() == 'C' && Graph::getCode(n) != "SS") {
-            int sumFlow = 0;
-            for (const auto e : n->getIncoming()) {
-                if (e->getType() == "residual")
-                    sumFlow+= e->getFlow();
-            }
-            result.push_back(make_pair(Graph::getCode(n), sumFlow));
-        }
+void Manager::disableReservoirs(vector<string> &reservoirs) {
+    for(string code : reservoirs) {
+        Vertex* v = findVertexInMap(code);
+        v->setEnabled(false);
+        bk.markVertexDirty(v);
     }
-    return result;
 }
 
-bool Manager::shutdownReservoirs(vector<pair<string, int>> (Manager::*flowfunction)(), vector<string> &reservoirs) {
-    auto beforeFlows = (this->*flowfunction)();
-
-    // Calculate flow before disable
-    int beforeTotalFlow = 0;
-    for (const auto& flow : beforeFlows)
-        beforeTotalFlow += flow.second;
-
-    // Calculate total demand
-    int totalDemand = 0;
-    for (const auto& v: getCities()) {
-        totalDemand+=dynamic_cast<City*>(v.second)->getDemand();
-    }
-    vector<pair<string,int>> afterFlows;
-    if (totalDemand <= beforeTotalFlow){
-        afterFlows = graphChangeFlowsAfterReservoirsDisabled(reservoirs);
-    }
-    else {
-        resetGraph();
-        disableReservoirs(reservoirs);
-        afterFlows = (this->*flowfunction)();
+void Manager::enableReservoirs(vector<string> &reservoirs) {
+    for(string code : reservoirs) {
+        Vertex* v = findVertexInMap(code);
+        v->setEnabled(true);
+        bk.markVertexDirty(v);
     }
-    // Calculate flow after disable
-    int afterTotalFlow = 0;
-    for (const auto& flow : afterFlows)
-        afterTotalFlow += flow.second;
+}
+
+bool Manager::shutdownReservoirs(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*), const vector<pair<string,int>>& beforeFlows, vector<string> &reservoirs, SweepWriter* sweep) {
+    Tracer::Scope scope("scenario", reservoirs.size() == 1 ? reservoirs[0] : string());
+    // Disable the reservoirs, repair the flow and bring the flow of the reservoirs back for the next scenario
+    disableReservoirs(reservoirs);
+    auto afterFlows = repairMaxFlow(explore_paths, reservoirs, {});
+    const FlowDiff diff = computeFlowDiff(beforeFlows, afterFlows);
+    if (sweep != nullptr) sweep->addScenario(getScenarioCode(reservoirs), beforeFlows, diff, pipeTable.getMetrics());
+    enableReservoirs(reservoirs);
+    restoreMaxFlow(explore_paths);
 
     // Check if the network was affected
-    if (afterTotalFlow == beforeTotalFlow) {
+    if (!diff.isAffected()) {
         cout << "The network was not affected after removing reservoirs: ";
         for (const string& code : reservoirs) {
             cout << code << ", ";
         }
         cout << endl;
-        resetGraph();
         return true;
     }
 
-    cout << "Percentage decline in flow for each city after removing reservoirs:" << endl;
+    cout << "Percentage decline in flow for each city after removing reservoirs:" << '\n';
     for (const string& code : reservoirs) {
         cout << code << ", ";
     }
-    cout << endl;
-    // Calculate the percentage decline for each city
-    vector<pair<string, double>> percentageDecline;
-    for (const auto& beforeFlow : beforeFlows) {
-        string cityCode = beforeFlow.first;
-        int beforeFlowAmount = beforeFlow.second;
-        double afterFlowAmount = 0;
-
-        // Find the flow amount after removing the stations
-        for (const auto& afterFlow : afterFlows) {
-            if (afterFlow.first == cityCode) {
-                afterFlowAmount = afterFlow.second;
-                break;
-            }
-
-        }
-
-        // Calculate the percentage decline in flow
-        double declinePercentage = (beforeFlowAmount - afterFlowAmount) / beforeFlowAmount * 100;
-        percentageDecline.push_back(make_pair(cityCode, declinePercentage));
-        cout << "City code: " << cityCode << ", Before flow : " << beforeFlowAmount << ", After flow : " << afterFlowAmount << ", Decline percentage : -" << declinePercentage << "%" << endl;
-
+    cout << '\n';
+    for (size_t i = 0; i < beforeFlows.size(); i++) {
+        cout << "City code: " << beforeFlows[i].first << ", Before flow : " << diff.before[i] << ", After flow : " << diff.after[i] << ", Decline percentage : -" << diff.decline[i] << "%" << '\n';
     }
-    resetGraph();
+    cout.flush();
     return false;
 
 }
 
 void Manager::disableEachReservoirEdmondsKarp() {
     vector<pair<string,bool>> can_be_disabled;
-    auto it = reservoirs.begin();
-    for (; it != reservoirs.end(); ++it) {
+    SweepWriter sweep(resultWriter.getPath("disabled_reservoirs_EK", ".sweep"));
+    // The reservoirs are listed before solving, which adds the super source to them
+    vector<string> allReservoirs;
+    for (const auto& reservoir : reservoirs) {
+        allReservoirs.push_back(reservoir.first);
+    }
+    const auto beforeFlows = maxFlow(&Manager::bfs_flow);
+    for (const string& code : allReservoirs) {
         vector<string> codes;
-        codes.push_back(it->first);
-        can_be_disabled.push_back(make_pair(it->first, shutdownReservoirs(&Manager::maxFlowEdmondsKarp,codes)));
+        codes.push_back(code);
+        can_be_disabled.push_back(make_pair(code, shutdownReservoirs(&Manager::bfs_flow,beforeFlows,codes,&sweep)));
     }
-    string path = "../data/results/results_disabled_reservoirs_EK.csv";
+    resetGraph();
+    string path = resultWriter.getPath("disabled_reservoirs_EK");
     createCsvFileDisable(path,can_be_disabled);
 }
 
 void Manager::disableEachReservoirFordFulkerson() {
     vector<pair<string,bool>> can_be_disabled;
-    auto it = reservoirs.begin();
-    for (; it != reservoirs.end(); ++it) {
+    SweepWriter sweep(resultWriter.getPath("disabled_reservoirs_FF", ".sweep"));
+    // The reservoirs are listed before solving, which adds the super source to them
+    vector<string> allReservoirs;
+    for (const auto& reservoir : reservoirs) {
+        allReservoirs.push_back(reservoir.first);
+    }
+    const auto beforeFlows = maxFlow(&Manager::dfs_flow);
+    for (const string& code : allReservoirs) {
         vector<string> codes;
-        codes.push_back(it->first);
-        can_be_disabled.push_back(make_pair(it->first, shutdownReservoirs(&Manager::maxFlowFordFulkerson,codes)));
+        codes.push_back(code);
+        can_be_disabled.push_back(make_pair(code, shutdownReservoirs(&Manager::dfs_flow,beforeFlows,codes,&sweep)));
     }
-    string path = "../data/results/results_disabled_reservoirs_FF.csv";
+    resetGraph();
+    string path = resultWriter.getPath("disabled_reservoirs_FF");
     createCsvFileDisable(path,can_be_disabled);
 }
-vector<pair<string,double>> Manager::shutdownReservoirsWithDecrease(vector<pair<string,int>> (Manager::*flowfunction)(),vector<string>& reservoirs){
+vector<pair<string,double>> Manager::shutdownReservoirsWithDecrease(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*),const vector<pair<string,int>>& beforeFlows,vector<string>& reservoirs){
+    Tracer::Scope scope("scenario", reservoirs.size() == 1 ? reservoirs[0] : string());
     vector<pair<string, double>> percentageDecline;
-    // Calculate total flow before removing the stations
-    auto beforeFlows = (this->*flowfunction)();
-    int beforeTotalFlow = 0;
-    for (const auto& flow : beforeFlows)
-        beforeTotalFlow += flow.second;
-    cout << "Total flow before removing reservoirs: " <<  beforeTotalFlow << endl;
-
-    // Calculate total demand
-    int totalDemand = 0;
-    for (const auto& v: getCities()) {
-        totalDemand+=dynamic_cast<City*>(v.second)->getDemand();
-    }
-    vector<pair<string,int>> afterFlows;
-    if (totalDemand <= beforeTotalFlow){
-        afterFlows = graphChangeFlowsAfterReservoirsDisabled(reservoirs);
-    }
-    else {
-        resetGraph();
-        disableReservoirs(reservoirs);
-        afterFlows = (this->*flowfunction)();
-    }
-
-    int afterTotalFlow = 0;
-    for (const auto& flow : afterFlows)
-        afterTotalFlow += flow.second;
-
+    // Disable the reservoirs, repair the flow and bring the flow of the reservoirs back
+    disableReservoirs(reservoirs);
+    auto afterFlows = repairMaxFlow(explore_paths, reservoirs, {});
+    enableReservoirs(reservoirs);
+    restoreMaxFlow(explore_paths);
+    const FlowDiff diff = computeFlowDiff(beforeFlows, afterFlows);
+    cout << "Total flow before removing reservoirs: " <<  diff.beforeTotal << '\n';
 
     // Check if the network was affected
-    if (afterTotalFlow == beforeTotalFlow) {
+    if (!diff.isAffected()) {
         cout << "The network was not affected after removing: ";
         for (const string& reservoir : reservoirs) {
             percentageDecline.push_back(make_pair(reservoir,0.0));
             cout << reservoir << ", ";
         }
-        cout << endl;
-        resetGraph();
+        cout << '\n';
     }
     // Calculate the percentage decline for each city
-    cout << "Percentage decline in flow for each city after removing stations:" << endl;
-
-    for (const auto& beforeFlow : beforeFlows) {
-        string cityCode = beforeFlow.first;
-        int beforeFlowAmount = beforeFlow.second;
-        double afterFlowAmount = 0;
-
-        // Find the flow amount after removing the stations
-        for (const auto& afterFlow : afterFlows) {
-            if (afterFlow.first == cityCode) {
-                afterFlowAmount = afterFlow.second;
-                break;
-            }
-        }
-
-        // Calculate the percentage decline in flow
-        double declinePercentage = -(beforeFlowAmount - afterFlowAmount) / beforeFlowAmount * 100;
-        percentageDecline.push_back(make_pair(cityCode, declinePercentage));
-        cout << "City code: " << cityCode << ", Before flow : " << beforeFlowAmount << ", After flow : " << afterFlowAmount << ", Decline percentage : " << declinePercentage << "%" << endl;
+    cout << "Percentage decline in flow for each city after removing stations:" << '\n';
 
+    for (size_t i = 0; i < beforeFlows.size(); i++) {
+        percentageDecline.push_back(make_pair(beforeFlows[i].first, diff.getChange(i)));
+        cout << "City code: " << beforeFlows[i].first << ", Before flow : " << diff.before[i] << ", After flow : " << diff.after[i] << ", Decline percentage : " << diff.getChange(i) << "%" << '\n';
     }
-
-    resetGraph();
-
+    cout.flush();
     return percentageDecline;
 }
 
 
 void Manager::disableSelectedReservoirsEdmondsKarp(vector<string> &reservoirs) {
-    vector<pair<string,double>> decreased = shutdownReservoirsWithDecrease(&Manager::maxFlowEdmondsKarp,reservoirs);
-    string path = "../data/results/results_decrease_after_disabled_reservoirs_EK.csv";
+    const auto beforeFlows = maxFlow(&Manager::bfs_flow);
+    vector<pair<string,double>> decreased = shutdownReservoirsWithDecrease(&Manager::bfs_flow,beforeFlows,reservoirs);
+    resetGraph();
+    string path = resultWriter.getPath("decrease_after_disabled_reservoirs_EK");
     createCsvFileRates(path,decreased);
 }
 void Manager::disableSelectedReservoirsFordFulkerson(vector<string> &reservoirs) {
-    vector<pair<string,double>> decreased = shutdownReservoirsWithDecrease(&Manager::maxFlowFordFulkerson,reservoirs);
-    string path = "../data/results/results_decrease_after_disabled_reservoirs_FF.csv";
+    const auto beforeFlows = maxFlow(&Manager::dfs_flow);
+    vector<pair<string,double>> decreased = shutdownReservoirsWithDecrease(&Manager::dfs_flow,beforeFlows,reservoirs);
+    resetGraph();
+    string path = resultWriter.getPath("decrease_after_disabled_reservoirs_FF");
     createCsvFileRates(path,decreased);
 }
 
@@ -1012,159 +1727,356 @@ void Manager::disableStations(vector<string>& stations) {
     for(string code : stations) {
         Vertex* v = findVertexInMap(code);
         v->setEnabled(false);
+        bk.markVertexDirty(v);
     }
 }
 
-bool Manager::shutdownStations(vector<pair<string,int>> (Manager::*flowfunction)(),vector<string>& codes) {
-    // Calculate total flow before removing the stations
-    auto beforeFlows = (this->*flowfunction)();
-    int beforeTotalFlow = 0;
-    for (const auto& flow : beforeFlows)
-        beforeTotalFlow += flow.second;
-    cout << "Total flow before removing stations: " <<  beforeTotalFlow << endl;
+void Manager::enableStations(vector<string>& stations) {
+    for(string code : stations) {
+        Vertex* v = findVertexInMap(code);
+        v->setEnabled(true);
+        bk.markVertexDirty(v);
+    }
+}
 
-    // Reset graph and disable stations
-    resetGraph();
+bool Manager::shutdownStations(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*),const vector<pair<string,int>>& beforeFlows,vector<string>& codes, SweepWriter* sweep) {
+    Tracer::Scope scope("scenario", codes.size() == 1 ? codes[0] : string());
+    // Disable the stations, repair the flow and bring the flow of the stations back for the next scenario
     disableStations(codes);
-
-    // Calculate total flow after removing the stations
-    auto afterFlows = (this->*flowfunction)();
-    int afterTotalFlow = 0;
-    for (const auto& flow : afterFlows)
-        afterTotalFlow += flow.second;
-    cout << "Total flow after removing stations: " << afterTotalFlow << endl;
+    auto afterFlows = repairMaxFlow(explore_paths, codes, {});
+    const FlowDiff diff = computeFlowDiff(beforeFlows, afterFlows);
+    if (sweep != nullptr) sweep->addScenario(getScenarioCode(codes), beforeFlows, diff, pipeTable.getMetrics());
+    enableStations(codes);
+    restoreMaxFlow(explore_paths);
+    cout << "Total flow before removing stations: " <<  diff.beforeTotal << '\n';
+    cout << "Total flow after removing stations: " << diff.afterTotal << '\n';
 
     // Check if the network was affected
-    if (afterTotalFlow == beforeTotalFlow) {
+    if (!diff.isAffected()) {
         cout << "The network was not affected after removing: ";
         for (const string& code : codes) {
             cout << code << ", ";
         }
         cout << endl;
-        resetGraph();
         return true;
     }
 
-    cout << "Percentage decline in flow for each city after removing stations:" << endl;
-
-    // Calculate the percentage decline for each city
-    vector<pair<string, double>> percentageDecline;
-    for (const auto& beforeFlow : beforeFlows) {
-        string cityCode = beforeFlow.first;
-        int beforeFlowAmount = beforeFlow.second;
-        double afterFlowAmount = 0;
-
-        // Find the flow amount after removing the stations
-        for (const auto& afterFlow : afterFlows) {
-            if (afterFlow.first == cityCode) {
-                afterFlowAmount = afterFlow.second;
-                break;
-            }
-        }
-
-        // Calculate the percentage decline in flow
-        double declinePercentage = (beforeFlowAmount - afterFlowAmount) / beforeFlowAmount * 100;
-        percentageDecline.push_back(make_pair(cityCode, declinePercentage));
-        cout << "City code: " << cityCode << ", Before flow : " << beforeFlowAmount << ", After flow : " << afterFlowAmount << ", Decline percentage : -" << declinePercentage << "%" << endl;
-
+    cout << "Percentage decline in flow for each city after removing stations:" << '\n';
+    for (size_t i = 0; i < beforeFlows.size(); i++) {
+        cout << "City code: " << beforeFlows[i].first << ", Before flow : " << diff.before[i] << ", After flow : " << diff.after[i] << ", Decline percentage : -" << diff.decline[i] << "%" << '\n';
     }
-    resetGraph();
+    cout.flush();
     return false;
 }
 
 void Manager::disableEachStationEdmondsKarp() {
     vector<pair<string,bool>> can_be_disabled;
+    SweepWriter sweep(resultWriter.getPath("disabled_stations_EK", ".sweep"));
+    const Criticality criticality = getCriticality();
+    const unordered_set<string> idle(criticality.idleStations.begin(), criticality.idleStations.end());
+    const auto beforeFlows = maxFlow(&Manager::bfs_flow);
+    const FlowMetrics beforeMetrics = pipeTable.getMetrics();
     auto it = stations.begin();
     for (; it != stations.end(); ++it) {
         vector<string> codes;
         codes.push_back(it->first);
-        can_be_disabled.push_back(make_pair(it->first, shutdownStations(&Manager::maxFlowEdmondsKarp,codes)));
+        if (idle.count(it->first)) {
+            can_be_disabled.push_back(make_pair(it->first, shutdownIdleStation(beforeFlows,beforeMetrics,codes,&sweep)));
+            continue;
+        }
+        can_be_disabled.push_back(make_pair(it->first, shutdownStations(&Manager::bfs_flow,beforeFlows,codes,&sweep)));
     }
-    string path = "../data/results/results_disabled_stations_EK.csv";
+    resetGraph();
+    string path = resultWriter.getPath("disabled_stations_EK");
     createCsvFileDisable(path,can_be_disabled);
 
 }
 
 void Manager::disableEachStationFordFulkerson() {
     vector<pair<string,bool>> can_be_disabled;
+    SweepWriter sweep(resultWriter.getPath("disabled_stations_FF", ".sweep"));
+    const Criticality criticality = getCriticality();
+    const unordered_set<string> idle(criticality.idleStations.begin(), criticality.idleStations.end());
+    const auto beforeFlows = maxFlow(&Manager::dfs_flow);
+    const FlowMetrics beforeMetrics = pipeTable.getMetrics();
     auto it = stations.begin();
     for (; it != stations.end(); ++it) {
         vector<string> codes;
         codes.push_back(it->first);
-        can_be_disabled.push_back(make_pair(it->first, shutdownStations(&Manager::maxFlowFordFulkerson,codes)));
+        if (idle.count(it->first)) {
+            can_be_disabled.push_back(make_pair(it->first, shutdownIdleStation(beforeFlows,beforeMetrics,codes,&sweep)));
+            continue;
+        }
+        can_be_disabled.push_back(make_pair(it->first, shutdownStations(&Manager::dfs_flow,beforeFlows,codes,&sweep)));
     }
-    string path = "../data/results/results_disabled_stations_FF.csv";
+    resetGraph();
+    string path = resultWriter.getPath("disabled_stations_FF");
     createCsvFileDisable(path,can_be_disabled);
 }
 
-vector<pair<string, double>> Manager::shutdownStationsGettingDecreaseFlows(vector<pair<string,int>> (Manager::*flowfunction)(),vector<string>& codes) {
-    vector<pair<string, double>> percentageDecline;
-    // Calculate total flow before removing the stations
-    auto beforeFlows = (this->*flowfunction)();
-    int beforeTotalFlow = 0;
-    for (const auto& flow : beforeFlows)
-        beforeTotalFlow += flow.second;
-    cout << "Total flow before removing stations: " <<  beforeTotalFlow << endl;
-
-    // Reset graph and disable stations
-    resetGraph();
+bool Manager::shutdownStationsBoykovKolmogorov(const vector<pair<string,int>>& beforeFlows,vector<string>& codes, SweepWriter* sweep) {
+    Tracer::Scope scope("scenario", codes.size() == 1 ? codes[0] : string());
+    // Disable stations and repair the flow of the previous scenario
     disableStations(codes);
-
-    // Calculate total flow after removing the stations
-    auto afterFlows = (this->*flowfunction)();
-    int afterTotalFlow = 0;
-    for (const auto& flow : afterFlows)
-        afterTotalFlow += flow.second;
-    cout << "Total flow after removing stations: " << afterTotalFlow << endl;
+    auto afterFlows = solveBoykovKolmogorov();
+    enableStations(codes);
+    const FlowDiff diff = computeFlowDiff(beforeFlows, afterFlows);
+    if (sweep != nullptr) sweep->addScenario(getScenarioCode(codes), beforeFlows, diff, pipeTable.getMetrics(bk.getNetwork()));
+    cout << "Total flow before removing stations: " <<  diff.beforeTotal << '\n';
+    cout << "Total flow after removing stations: " << diff.afterTotal << '\n';
 
     // Check if the network was affected
-    if (afterTotalFlow == beforeTotalFlow) {
+    if (!diff.isAffected()) {
         cout << "The network was not affected after removing: ";
         for (const string& code : codes) {
-            percentageDecline.push_back(make_pair(code,0.0));
             cout << code << ", ";
         }
         cout << endl;
-        resetGraph();
+        return true;
     }
 
-    // Calculate the percentage decline for each city
-    cout << "Percentage decline in flow for each city after removing stations:" << endl;
-
-    for (const auto& beforeFlow : beforeFlows) {
-        string cityCode = beforeFlow.first;
-        int beforeFlowAmount = beforeFlow.second;
-        double afterFlowAmount = 0;
-
-        // Find the flow amount after removing the stations
-        for (const auto& afterFlow : afterFlows) {
-            if (afterFlow.first == cityCode) {
-                afterFlowAmount = afterFlow.second;
-                break;
+    cout << "Percentage decline in flow for each city after removing stations:" << '\n';
+    for (size_t i = 0; i < beforeFlows.size(); i++) {
+        cout << "City code: " << beforeFlows[i].first << ", Before flow : " << diff.before[i] << ", After flow : " << diff.after[i] << ", Decline percentage : -" << diff.decline[i] << "%" << '\n';
+    }
+    cout.flush();
+    return false;
+}
+
+bool Manager::shutdownIdleStation(const vector<pair<string,int>>& beforeFlows,const FlowMetrics& beforeMetrics,vector<string>& codes, SweepWriter* sweep) {
+    Tracer::Scope scope("scenario", codes.size() == 1 ? codes[0] : string());
+    const FlowDiff diff = computeFlowDiff(beforeFlows, beforeFlows);
+    if (sweep != nullptr) sweep->addScenario(getScenarioCode(codes), beforeFlows, diff, beforeMetrics);
+    cout << "Total flow before removing stations: " <<  diff.beforeTotal << '\n';
+    cout << "Total flow after removing stations: " << diff.afterTotal << '\n';
+    cout << "The network was not affected after removing: ";
+    for (const string& code : codes) {
+        cout << code << ", ";
+    }
+    cout << "no reservoir reaches a city through it" << endl;
+    return true;
+}
+
+void Manager::disableEachStationBoykovKolmogorov() {
+    vector<pair<string,bool>> can_be_disabled;
+    SweepWriter sweep(resultWriter.getPath("disabled_stations_BK", ".sweep"));
+    const Criticality criticality = getCriticality();
+    const unordered_set<string> idle(criticality.idleStations.begin(), criticality.idleStations.end());
+    const auto beforeFlows = maxFlowBoykovKolmogorov();
+    const FlowMetrics beforeMetrics = pipeTable.getMetrics();
+    pipeTable.bind(bk.getNetwork());
+    auto it = stations.begin();
+    for (; it != stations.end(); ++it) {
+        vector<string> codes;
+        codes.push_back(it->first);
+        if (idle.count(it->first)) {
+            can_be_disabled.push_back(make_pair(it->first, shutdownIdleStation(beforeFlows,beforeMetrics,codes,&sweep)));
+            continue;
+        }
+        can_be_disabled.push_back(make_pair(it->first, shutdownStationsBoykovKolmogorov(beforeFlows,codes,&sweep)));
+    }
+    resetGraph();
+    string path = resultWriter.getPath("disabled_stations_BK");
+    createCsvFileDisable(path,can_be_disabled);
+}
+
+Criticality Manager::getCriticality() const {
+    // Index 0 is a root linked to every reservoir, then one index per vertex and one per pipe
+    unordered_map<const Vertex*, int> index;
+    vector<Vertex*> vertexes = {nullptr};
+    for (const auto v : graph->getVertexSet()) {
+        const string& code = Graph::getCode(v);
+        if (code == "SR" || code == "SS") continue;
+        index[v] = static_cast<int>(vertexes.size());
+        vertexes.push_back(v);
+    }
+    const int firstPipe = static_cast<int>(vertexes.size());
+    vector<Edge*> pipes;
+    unordered_map<const Edge*, int> pipeIndex;
+    vector<pair<int,int>> arcs;
+    for (int i = 1; i < firstPipe; i++) {
+        Vertex* v = vertexes[i];
+        if (v->getType() == 'R') arcs.emplace_back(0, i);
+        for (const auto e : v->getAdj()) {
+            const auto dest = index.find(e->getDest());
+            if (e->getType() != "normal" || dest == index.end()) continue;
+            // Both directions of a two-way pipe go through the same vertex, so removing it removes the pipe
+            const auto reverse = e->getReverseEdge() == nullptr ? pipeIndex.end() : pipeIndex.find(e->getReverseEdge());
+            int p = firstPipe + static_cast<int>(pipes.size());
+            if (reverse != pipeIndex.end()) p = reverse->second;
+            else pipes.push_back(e);
+            pipeIndex[e] = p;
+            arcs.emplace_back(i, p);
+            arcs.emplace_back(p, dest->second);
+        }
+    }
+    const int n = firstPipe + static_cast<int>(pipes.size());
+    const DominatorTree tree(n, arcs, 0);
+
+    // Vertexes that reach a city, following the arcs backwards
+    vector<vector<int>> predecessors(n);
+    for (const auto& [u, v] : arcs) predecessors[v].push_back(u);
+    vector<unsigned char> reachesCity(n, 0);
+    queue<int> q;
+    for (int i = 1; i < firstPipe; i++) {
+        if (vertexes[i]->getType() == 'C') {
+            reachesCity[i] = 1;
+            q.push(i);
+        }
+    }
+    while (!q.empty()) {
+        const int v = q.front();
+        q.pop();
+        for (const int u : predecessors[v]) {
+            if (!reachesCity[u]) {
+                reachesCity[u] = 1;
+                q.push(u);
+            }
+        }
+    }
+
+    Criticality criticality;
+    vector<int> element(n, -1);
+    for (int i = 1; i < firstPipe; i++) {
+        Vertex* v = vertexes[i];
+        const string& code = Graph::getCode(v);
+        if (v->getType() == 'S' && (!tree.isReachable(i) || !reachesCity[i])) {
+            criticality.idleStations.push_back(code);
+        }
+        if (v->getType() != 'C') continue;
+        if (!tree.isReachable(i)) {
+            criticality.unreachableCities.push_back(code);
+            continue;
+        }
+
+        // Every station and pipe on the way up the tree is on every route to the city
+        const int demand = cityTable.getDemand(cityTable.getIndex(code));
+        for (int d = tree.getImmediateDominator(i); d > 0; d = tree.getImmediateDominator(d)) {
+            const bool pipe = d >= firstPipe;
+            if (!pipe && vertexes[d]->getType() != 'S') continue;
+            auto& elements = pipe ? criticality.pipes : criticality.stations;
+            if (element[d] < 0) {
+                element[d] = static_cast<int>(elements.size());
+                if (pipe) {
+                    // A two-way pipe is named in the direction the water crosses it
+                    const Edge* e = pipes[d - firstPipe];
+                    const bool reversed = e->getReverseEdge() != nullptr && tree.dominates(d, index.at(e->getOrigin()));
+                    elements.push_back({Graph::getCode(reversed ? e->getDest() : e->getOrigin()), Graph::getCode(reversed ? e->getOrigin() : e->getDest()), {}, 0});
+                }
+                else {
+                    elements.push_back({Graph::getCode(vertexes[d]), "", {}, 0});
+                }
             }
+            elements[element[d]].cities.push_back(code);
+            elements[element[d]].demand += demand;
         }
+    }
 
-        // Calculate the percentage decline in flow
-        double declinePercentage = -(beforeFlowAmount - afterFlowAmount) / beforeFlowAmount * 100;
-        percentageDecline.push_back(make_pair(cityCode, declinePercentage));
-        cout << "City code: " << cityCode << " ,Before flow : " << beforeFlowAmount << ", After flow : " << afterFlowAmount << ", Decline percentage : -" << declinePercentage << "%" << endl;
+    auto byDemand = [](const Criticality::Element& a, const Criticality::Element& b) { return a.demand > b.demand; };
+    stable_sort(criticality.stations.begin(), criticality.stations.end(), byDemand);
+    stable_sort(criticality.pipes.begin(), criticality.pipes.end(), byDemand);
+    return criticality;
+}
 
+void Manager::writeCriticality(ostream& out, const Criticality& criticality) {
+    out << "Type,Origin,Destination,Demand,Cities" << '\n';
+    for (const auto* elements : {&criticality.stations, &criticality.pipes}) {
+        for (const auto& element : *elements) {
+            out << (element.destination.empty() ? "Station" : "Pipe") << "," << element.origin << "," << element.destination << "," << element.demand << ",";
+            for (size_t i = 0; i < element.cities.size(); i++) {
+                out << (i > 0 ? " " : "") << element.cities[i];
+            }
+            out << '\n';
+        }
     }
+    out << '\n' << "Idle station" << '\n';
+    for (const auto& code : criticality.idleStations) {
+        out << code << '\n';
+    }
+    out << '\n' << "Unreachable city" << '\n';
+    for (const auto& code : criticality.unreachableCities) {
+        out << code << '\n';
+    }
+}
 
-    resetGraph();
+void Manager::criticalElements() {
+    const Criticality criticality = getCriticality();
+    cout << criticality.stations.size() << " stations and " << criticality.pipes.size() << " pipes cut cities off from every reservoir:" << "\n";
+    for (const auto* elements : {&criticality.stations, &criticality.pipes}) {
+        for (const auto& element : *elements) {
+            if (element.destination.empty()) cout << "Station " << element.origin;
+            else cout << "Pipe " << element.origin << " -> " << element.destination;
+            cout << " cuts off a demand of " << element.demand << ":";
+            for (size_t i = 0; i < element.cities.size(); i++) {
+                cout << (i == 0 ? " " : ", ") << element.cities[i];
+            }
+            cout << "\n";
+        }
+    }
+    if (!criticality.idleStations.empty()) {
+        cout << "Stations on no route from a reservoir to a city:";
+        for (size_t i = 0; i < criticality.idleStations.size(); i++) {
+            cout << (i == 0 ? " " : ", ") << criticality.idleStations[i];
+        }
+        cout << "\n";
+    }
+    if (!criticality.unreachableCities.empty()) {
+        cout << "Cities no reservoir reaches:";
+        for (size_t i = 0; i < criticality.unreachableCities.size(); i++) {
+            cout << (i == 0 ? " " : ", ") << criticality.unreachableCities[i];
+        }
+        cout << "\n";
+    }
+    cout.flush();
+    createCsvFileCriticality(resultWriter.getPath("critical_elements"), criticality);
+}
+
+vector<pair<string, double>> Manager::shutdownStationsGettingDecreaseFlows(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*),const vector<pair<string,int>>& beforeFlows,vector<string>& codes) {
+    Tracer::Scope scope("scenario", codes.size() == 1 ? codes[0] : string());
+    vector<pair<string, double>> percentageDecline;
+    // Disable the stations, repair the flow and bring the flow of the stations back
+    disableStations(codes);
+    auto afterFlows = repairMaxFlow(explore_paths, codes, {});
+    enableStations(codes);
+    restoreMaxFlow(explore_paths);
+    const FlowDiff diff = computeFlowDiff(beforeFlows, afterFlows);
+    cout << "Total flow before removing stations: " <<  diff.beforeTotal << '\n';
+    cout << "Total flow after removing stations: " << diff.afterTotal << '\n';
+
+    // Check if the network was affected
+    if (!diff.isAffected()) {
+        cout << "The network was not affected after removing: ";
+        for (const string& code : codes) {
+            percentageDecline.push_back(make_pair(code,0.0));
+            cout << code << ", ";
+        }
+        cout << '\n';
+    }
+
+    // Calculate the percentage decline for each city
+    cout << "Percentage decline in flow for each city after removing stations:" << '\n';
 
+    for (size_t i = 0; i < beforeFlows.size(); i++) {
+        percentageDecline.push_back(make_pair(beforeFlows[i].first, diff.getChange(i)));
+        cout << "City code: " << beforeFlows[i].first << " ,Before flow : " << diff.before[i] << ", After flow : " << diff.after[i] << ", Decline percentage : -" << diff.getChange(i) << "%" << '\n';
+    }
+    cout.flush();
     return percentageDecline;
 }
 
 void Manager::disableSelectedStationsEdmondsKarp(vector<string>& stations) {
-    vector<pair<string,double>> decreased = shutdownStationsGettingDecreaseFlows(&Manager::maxFlowEdmondsKarp,stations);
-    string path = "../data/results/results_decrease_after_disabled_stationsEK.csv";
+    const auto beforeFlows = maxFlow(&Manager::bfs_flow);
+    vector<pair<string,double>> decreased = shutdownStationsGettingDecreaseFlows(&Manager::bfs_flow,beforeFlows,stations);
+    resetGraph();
+    string path = resultWriter.getPath("decrease_after_disabled_stationsEK");
     createCsvFileRates(path,decreased);
 }
 
 void Manager::disableSelectedStationsFordFulkerson(vector<string> &stations) {
-    vector<pair<string,double>> decreased = shutdownStationsGettingDecreaseFlows(&Manager::maxFlowFordFulkerson,stations);
-    string path = "../data/results/results_decrease_after_disabled_stationsFF.csv";
+    const auto beforeFlows = maxFlow(&Manager::dfs_flow);
+    vector<pair<string,double>> decreased = shutdownStationsGettingDecreaseFlows(&Manager::dfs_flow,beforeFlows,stations);
+    resetGraph();
+    string path = resultWriter.getPath("decrease_after_disabled_stationsFF");
     createCsvFileRates(path,decreased);
 }
 
@@ -1176,167 +2088,173 @@ void Manager::disablePipes(vector<Edge*>& pipes) {
         if (p->getReverseEdge() != nullptr){
             p->getReverseEdge()->setEnabled(false);
         }
+        bk.markEdgeDirty(p);
     }
 }
 
-bool Manager::shutdownPipes(vector<pair<string,int>> (Manager::*flowfunction)(),vector<Edge*> &pipes) {
-      // Calculate total flow before removing the stations
-    auto beforeFlows = (this->*flowfunction)();
-    int beforeTotalFlow = 0;
-    for (const auto& flow : beforeFlows)
-        beforeTotalFlow += flow.second;
+void Manager::enablePipes(vector<Edge*>& pipes) {
+    for(auto p: pipes) {
+        p->setEnabled(true);
+        if (p->getReverseEdge() != nullptr){
+            p->getReverseEdge()->setEnabled(true);
+        }
+        bk.markEdgeDirty(p);
+    }
+}
 
-    // Reset graph and disable stations
-    resetGraph();
+bool Manager::shutdownPipes(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*),const vector<pair<string,int>>& beforeFlows,vector<Edge*> &pipes, SweepWriter* sweep) {
+    Tracer::Scope scope("scenario");
+    // Disable the pipes, repair the flow and bring the flow of the pipes back for the next scenario
     disablePipes(pipes);
-
-    // Calculate total flow after removing the stations
-    auto afterFlows = (this->*flowfunction)();
-    int afterTotalFlow = 0;
-    for (const auto& flow : afterFlows)
-        afterTotalFlow += flow.second;
+    auto afterFlows = repairMaxFlow(explore_paths, {}, pipes);
+    const FlowDiff diff = computeFlowDiff(beforeFlows, afterFlows);
+    if (sweep != nullptr) sweep->addScenario(getScenarioCode(pipes), beforeFlows, diff, pipeTable.getMetrics());
+    enablePipes(pipes);
+    restoreMaxFlow(explore_paths);
 
     // Check if the network was affected
-    if (afterTotalFlow == beforeTotalFlow) {
-        cout << "The network was not affected after removing pipes: " << endl;
+    if (!diff.isAffected()) {
+        cout << "The network was not affected after removing pipes: " << '\n';
         for (const auto pipe : pipes) {
-            cout << "Origin: " <<  Graph::getCode(pipe->getOrigin()) << " Destination: " << Graph::getCode(pipe->getDest()) << endl;
+            cout << "Origin: " <<  Graph::getCode(pipe->getOrigin()) << " Destination: " << Graph::getCode(pipe->getDest()) << '\n';
         }
         cout << endl;
-        resetGraph();
         return true;
     }
 
-    // Calculate the percentage decline for each city
-    vector<pair<string, double>> percentageDecline;
-    for (const auto& beforeFlow : beforeFlows) {
-        string cityCode = beforeFlow.first;
-        int beforeFlowAmount = beforeFlow.second;
-        double afterFlowAmount = 0;
-
-        // Find the flow amount after removing the stations
-        for (const auto& afterFlow : afterFlows) {
-            if (afterFlow.first == cityCode) {
-                afterFlowAmount = afterFlow.second;
-                break;
-            }
-        }
-
-        // Calculate the percentage decline in flow
-        double declinePercentage = (beforeFlowAmount - afterFlowAmount) / beforeFlowAmount * 100;
-        percentageDecline.push_back(make_pair(cityCode, declinePercentage));
-    }
-
-    cout << "Percentage decline in flow for each city after removing pipes: " << endl;
+    cout << "Percentage decline in flow for each city after removing pipes: " << '\n';
     for (const auto pipe : pipes) {
-        cout << "Origin: " <<  Graph::getCode(pipe->getOrigin()) << " Destination: " << Graph::getCode(pipe->getDest()) << endl;
-
-    }
-    for (const auto& entry : percentageDecline) {
-        if(entry.second == 0.0) {
-            cout << "City code: " << entry.first << ", Percentage Decline: " << entry.second << "%" << endl;
-        }
-        else {
-            cout << "City code: " << entry.first << ", Percentage Decline: -" << entry.second << "%" << endl;
-        }
+        cout << "Origin: " <<  Graph::getCode(pipe->getOrigin()) << " Destination: " << Graph::getCode(pipe->getDest()) << '\n';
     }
+    printPipeDecline(beforeFlows, diff);
     cout << endl;
-    resetGraph();
-
     return false;
 }
 
 void Manager::disableEachPipeEdmondsKarp() {
     vector<pair<Edge*,bool>> can_be_disabled;
+    SweepWriter sweep(resultWriter.getPath("can_pipe_be_disabled_EK", ".sweep"));
+    // The pipes are listed before solving, which adds the super source, the super sink and residual edges
+    vector<Edge*> allPipes;
     for (auto v : graph->getVertexSet()) {
         for (auto e : v->getAdj()) {
-            vector<Edge*> pipes;
-            pipes.push_back(e);
-            can_be_disabled.push_back(make_pair(e, shutdownPipes(&Manager::maxFlowEdmondsKarp,pipes)));
+            allPipes.push_back(e);
         }
     }
-    string path = "../data/results/results_can_pipe_be_disabled_EK.csv";
+    const auto beforeFlows = maxFlow(&Manager::bfs_flow);
+    for (auto e : allPipes) {
+        vector<Edge*> pipes;
+        pipes.push_back(e);
+        can_be_disabled.push_back(make_pair(e, shutdownPipes(&Manager::bfs_flow,beforeFlows,pipes,&sweep)));
+    }
+    resetGraph();
+    string path = resultWriter.getPath("can_pipe_be_disabled_EK");
     createCsvFilePipesDisable(path,can_be_disabled);
 }
 
 void Manager::disableEachPipeFordFulkerson() {
     vector<pair<Edge*,bool>> can_be_disabled;
+    SweepWriter sweep(resultWriter.getPath("can_pipe_be_disabled_FF", ".sweep"));
+    // The pipes are listed before solving, which adds the super source, the super sink and residual edges
+    vector<Edge*> allPipes;
     for (auto v : graph->getVertexSet()) {
         for (auto e : v->getAdj()) {
-            vector<Edge*> pipes;
-            pipes.push_back(e);
-            can_be_disabled.push_back(make_pair(e, shutdownPipes(&Manager::maxFlowFordFulkerson,pipes)));
+            allPipes.push_back(e);
         }
     }
-    string path = "../data/results/results_can_pipe_be_disabled_FF.csv";
+    const auto beforeFlows = maxFlow(&Manager::dfs_flow);
+    for (auto e : allPipes) {
+        vector<Edge*> pipes;
+        pipes.push_back(e);
+        can_be_disabled.push_back(make_pair(e, shutdownPipes(&Manager::dfs_flow,beforeFlows,pipes,&sweep)));
+    }
+    resetGraph();
+    string path = resultWriter.getPath("can_pipe_be_disabled_FF");
     createCsvFilePipesDisable(path,can_be_disabled);
 }
 
+bool Manager::shutdownPipesBoykovKolmogorov(const vector<pair<string,int>>& beforeFlows,vector<Edge*> &pipes, SweepWriter* sweep) {
+    Tracer::Scope scope("scenario");
+    // Disable pipes and repair the flow of the previous scenario
+    disablePipes(pipes);
+    auto afterFlows = solveBoykovKolmogorov();
+    enablePipes(pipes);
+    const FlowDiff diff = computeFlowDiff(beforeFlows, afterFlows);
+    if (sweep != nullptr) sweep->addScenario(getScenarioCode(pipes), beforeFlows, diff, pipeTable.getMetrics(bk.getNetwork()));
+
+    // Check if the network was affected
+    if (!diff.isAffected()) {
+        cout << "The network was not affected after removing pipes: " << '\n';
+        for (const auto pipe : pipes) {
+            cout << "Origin: " <<  Graph::getCode(pipe->getOrigin()) << " Destination: " << Graph::getCode(pipe->getDest()) << '\n';
+        }
+        cout << endl;
+        return true;
+    }
 
-vector<pair<string,double>> Manager::shutdownPipesWithDecrease(vector<pair<string,int>> (Manager::*flowfunction)(),vector<Edge*>& pipes) {
+    cout << "Percentage decline in flow for each city after removing pipes: " << '\n';
+    for (const auto pipe : pipes) {
+        cout << "Origin: " <<  Graph::getCode(pipe->getOrigin()) << " Destination: " << Graph::getCode(pipe->getDest()) << '\n';
+    }
+    printPipeDecline(beforeFlows, diff);
+    cout << endl;
+    return false;
+}
 
-    vector<pair<string, double>> percentageDecline;
-    // Calculate total flow before removing the stations
-    auto beforeFlows = (this->*flowfunction)();
-    int beforeTotalFlow = 0;
-    for (const auto& flow : beforeFlows)
-        beforeTotalFlow += flow.second;
+void Manager::disableEachPipeBoykovKolmogorov() {
+    vector<pair<Edge*,bool>> can_be_disabled;
+    SweepWriter sweep(resultWriter.getPath("can_pipe_be_disabled_BK", ".sweep"));
+    vector<Edge*> allPipes;
+    for (auto v : graph->getVertexSet()) {
+        for (auto e : v->getAdj()) {
+            allPipes.push_back(e);
+        }
+    }
+    const auto beforeFlows = maxFlowBoykovKolmogorov();
+    pipeTable.bind(bk.getNetwork());
+    for (auto e : allPipes) {
+        vector<Edge*> pipes;
+        pipes.push_back(e);
+        can_be_disabled.push_back(make_pair(e, shutdownPipesBoykovKolmogorov(beforeFlows,pipes,&sweep)));
+    }
+    resetGraph();
+    string path = resultWriter.getPath("can_pipe_be_disabled_BK");
+    createCsvFilePipesDisable(path,can_be_disabled);
+}
 
-    // Reset graph and disable stations
 
-    disablePipes(pipes);
+vector<pair<string,double>> Manager::shutdownPipesWithDecrease(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*),const vector<pair<string,int>>& beforeFlows,vector<Edge*>& pipes) {
+    Tracer::Scope scope("scenario");
 
-    // Calculate total flow after removing the stations
-    auto afterFlows = (this->*flowfunction)();
-    int afterTotalFlow = 0;
-    for (const auto& flow : afterFlows)
-        afterTotalFlow += flow.second;
+    vector<pair<string, double>> percentageDecline;
+    // Disable the pipes, repair the flow and bring the flow of the pipes back
+    disablePipes(pipes);
+    auto afterFlows = repairMaxFlow(explore_paths, {}, pipes);
+    enablePipes(pipes);
+    restoreMaxFlow(explore_paths);
+    const FlowDiff diff = computeFlowDiff(beforeFlows, afterFlows);
 
     // Check if the network was affected
-    if (afterTotalFlow == beforeTotalFlow) {
-        cout << "The network was not affected after removing pipes: " << endl;
+    if (!diff.isAffected()) {
+        cout << "The network was not affected after removing pipes: " << '\n';
         for (auto pipe:pipes) {
-            cout << "Origin: " <<  Graph::getCode(pipe->getOrigin()) << " Destination: " << Graph::getCode(pipe->getDest()) << endl;
+            cout << "Origin: " <<  Graph::getCode(pipe->getOrigin()) << " Destination: " << Graph::getCode(pipe->getDest()) << '\n';
         }
         for (auto flow : afterFlows) {
             percentageDecline.push_back(make_pair(flow.first,0.0));
         }
         cout << endl;
-        resetGraph();
         return percentageDecline;
     }
 
     // Calculate the percentage decline for each city
-
-    for (const auto& beforeFlow : beforeFlows) {
-        string cityCode = beforeFlow.first;
-        int beforeFlowAmount = beforeFlow.second;
-        double afterFlowAmount = 0;
-
-        // Find the flow amount after removing the stations
-        for (const auto& afterFlow : afterFlows) {
-            if (afterFlow.first == cityCode) {
-                afterFlowAmount = afterFlow.second;
-                break;
-            }
-        }
-
-        // Calculate the percentage decline in flow
-        double declinePercentage = -(beforeFlowAmount - afterFlowAmount) / beforeFlowAmount * 100;
-        percentageDecline.push_back(make_pair(cityCode, declinePercentage));
-    }
-
-    cout << "Percentage decline in flow for each city after removing stations:" << endl;
-    for (const auto& entry : percentageDecline) {
-        if(entry.second == 0.0) {
-            cout << "City code: " << entry.first << ", Percentage Decline: " << entry.second << "%" << endl;
-        }
-        else {
-            cout << "City code: " << entry.first << ", Percentage Decline: " << entry.second << "%" << endl;
-        }
+    percentageDecline.reserve(beforeFlows.size());
+    cout << "Percentage decline in flow for each city after removing stations:" << '\n';
+    for (size_t i = 0; i < beforeFlows.size(); i++) {
+        percentageDecline.push_back(make_pair(beforeFlows[i].first, diff.getChange(i)));
+        cout << "City code: " << beforeFlows[i].first << ", Percentage Decline: " << diff.getChange(i) << "%" << '\n';
     }
-    resetGraph();
-
+    cout.flush();
     return percentageDecline;
 }
 
@@ -1344,16 +2262,20 @@ void Manager::disableSelectedPipesEdmondsKarp(vector<Edge*> &pipes) {
     for (auto e : pipes){
         cout << Graph::getCode(e->getOrigin()) << Graph::getCode(e->getDest());
     }
-    vector<pair<string,double>> decreased = shutdownPipesWithDecrease(&Manager::maxFlowEdmondsKarp,pipes);
+    const auto beforeFlows = maxFlow(&Manager::bfs_flow);
+    vector<pair<string,double>> decreased = shutdownPipesWithDecrease(&Manager::bfs_flow,beforeFlows,pipes);
+    resetGraph();
 
-    string path = "../data/results/results_decrease_rate_pipe_disabled_EK.csv";
+    string path = resultWriter.getPath("decrease_rate_pipe_disabled_EK");
     createCsvFileRates(path,decreased);
 
 }
 
 void Manager::disableSelectedPipesFordFulkerson(vector<Edge *> &pipes) {
-    vector<pair<string,double>> decreased = shutdownPipesWithDecrease(&Manager::maxFlowFordFulkerson,pipes);
-    string path = "../data/results/results_decrease_rate_pipe_disabled_FF.csv";
+    const auto beforeFlows = maxFlow(&Manager::dfs_flow);
+    vector<pair<string,double>> decreased = shutdownPipesWithDecrease(&Manager::dfs_flow,beforeFlows,pipes);
+    resetGraph();
+    string path = resultWriter.getPath("decrease_rate_pipe_disabled_FF");
     createCsvFileRates(path,decreased);
 }
 
@@ -1379,13 +2301,13 @@ void Manager::printTopKFlows(vector<pair<string, int>>& flows, int k, const stri
 
 void Manager::topKFlowEdmondsKarpCities(const int k) {
     auto flows = maxFlowEdmondsKarp();
-    printTopKFlows(flows, k, "../data/results/results_TopK_EK.csv");
+    printTopKFlows(flows, k, resultWriter.getPath("TopK_EK"));
     resetGraph();
 }
 
 void Manager::topKFlowFordFulkersonCities(const int k) {
     auto flows = maxFlowFordFulkerson();
-    printTopKFlows(flows, k, "../data/results/results_TopK_FF.csv");
+    printTopKFlows(flows, k, resultWriter.getPath("TopK_FF"));
     resetGraph();
 }
 
@@ -1407,85 +2329,309 @@ void Manager::calculateFlowRates(const vector<pair<string, int>>& flows, const s
 
 void Manager::flowRatePerCityEdmondsKarp() {
     auto flows = maxFlowEdmondsKarp();
-    calculateFlowRates(flows, "../data/results/results_rateFlows_EK.csv");
+    calculateFlowRates(flows, resultWriter.getPath("rateFlows_EK"));
     resetGraph();
 }
 
 void Manager::flowRatePerCityFordFulkerson() {
     auto flows = maxFlowFordFulkerson();
-    calculateFlowRates(flows, "../data/results/results_rateFlows_FF.csv");
+    calculateFlowRates(flows, resultWriter.getPath("rateFlows_FF"));
     resetGraph();
 }
 
-vector<int> Manager::getMetrics() {
-
-    vector<int> metrics;
+void Manager::writeFlowPaths(ostream& out, const FlowDecomposition& decomposition) {
+    out << "Reservoir,City,Flow,Path" << endl;
 
-    graph->resetVisited();
+    for (int i = 0; i < decomposition.getNumberOfPaths(); i++) {
+        out << Graph::getCode(decomposition.getReservoir(i)) << "," << Graph::getCode(decomposition.getCity(i)) << "," << decomposition.getFlow(i) << ",";
+        for (int j = 0; j < decomposition.getLength(i); j++) {
+            if (j > 0) out << " -> ";
+            out << Graph::getCode(decomposition.getVertex(i, j));
+        }
+        out << "\n";
+    }
+}
 
-    int mn = -1;
-    int mx = 0;
-    int mx_dif = 0;
-    int sum = 0;
-    int sum_dif = 0;
-    int n = 0;
+void Manager::printFlowPaths(const FlowDecomposition& decomposition, const string& outputFile) {
+    for (int i = 0; i < decomposition.getNumberOfPaths(); i++) {
+        cout << "Path " << i + 1 << " : " << Graph::getCode(decomposition.getReservoir(i)) << " -> " << Graph::getCode(decomposition.getCity(i))
+             << " with " << decomposition.getLength(i) << " vertexes, flow -> " << decomposition.getFlow(i) << endl;
+    }
+    cout << "The flow is split into " << decomposition.getNumberOfPaths() << " paths with a total flow of " << decomposition.getTotalFlow() << endl;
 
-    for(auto a : graph->getVertexSet()){
+    createCsvFileFlowPaths(outputFile, decomposition);
+}
 
-        if(a->isVisited())continue;
-            a->setVisited(true);
+FlowDecomposition Manager::getFlowPathsEdmondsKarp() {
+    maxFlowEdmondsKarp();
+    FlowDecomposition decomposition = decomposeFlow();
+    resetGraph();
+    return decomposition;
+}
 
-        for(auto b: a->getAdj()){
+void Manager::flowPathsEdmondsKarp() {
+    printFlowPaths(getFlowPathsEdmondsKarp(), resultWriter.getPath("flowPaths_EK"));
+}
 
-            int f = b->getFlow();
-            int c = b->getCapacity();
-            int dif = c - f;
+void Manager::flowPathsFordFulkerson() {
+    maxFlowFordFulkerson();
+    printFlowPaths(decomposeFlow(), resultWriter.getPath("flowPaths_FF"));
+    resetGraph();
+}
 
-            sum += f;
-            sum_dif += dif;
-            if(mn == -1 or mn > f)mn = f;
-            if(mx == -1 or mx < f)mx = f;
-            if(dif > mx_dif)mx_dif = dif;
+void Manager::writeAttribution(ostream& out, const AttributionMatrix& matrix, const int city) {
+    out << "Reservoir,City,Flow,Share" << endl;
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << fixed << setprecision(3);
 
-            n += 1;
+    for (int c = 0; c < matrix.getNumberOfCities(); c++) {
+        if (city >= 0 && c != city) continue;
+        const double total = matrix.getCityTotal(c);
+        for (int r = 0; r < matrix.getNumberOfReservoirs(); r++) {
+            const double flow = matrix.get(r, c);
+            if (flow <= 0) continue;
+            out << Graph::getCode(matrix.getReservoir(r)) << "," << Graph::getCode(matrix.getCity(c)) << "," << flow << "," << flow / total * 100 << "%" << "\n";
         }
-
     }
+    out.flags(flags);
+    out.precision(precision);
+}
 
-    graph->resetVisited();
+void Manager::printAttribution(const AttributionMatrix& matrix, const string& outputFile) {
+    for (int c = 0; c < matrix.getNumberOfCities(); c++) {
+        cout << "City code: " << Graph::getCode(matrix.getCity(c)) << " receives " << matrix.getCityTotal(c) << " from";
+        bool supplied = false;
+        for (int r = 0; r < matrix.getNumberOfReservoirs(); r++) {
+            if (matrix.get(r, c) <= 0) continue;
+            cout << " " << Graph::getCode(matrix.getReservoir(r)) << " (" << matrix.get(r, c) << ")";
+            supplied = true;
+        }
+        if (!supplied) cout << " no reservoir";
+        cout << endl;
+    }
 
-    int mean = sum_dif/n;
-    int variance = 0;
+    createCsvFileAttribution(outputFile, matrix);
+}
 
-    for(auto a : graph->getVertexSet()){
+AttributionMatrix Manager::getAttributionEdmondsKarp() {
+    maxFlowEdmondsKarp();
+    AttributionMatrix matrix = attributeFlow();
+    resetGraph();
+    return matrix;
+}
 
-        if(a->isVisited())continue;
-        a->setVisited(true);
+void Manager::attributionEdmondsKarp() {
+    printAttribution(getAttributionEdmondsKarp(), resultWriter.getPath("attribution_EK"));
+}
 
-        for(auto b: a->getAdj()){
+void Manager::attributionFordFulkerson() {
+    maxFlowFordFulkerson();
+    printAttribution(attributeFlow(), resultWriter.getPath("attribution_FF"));
+    resetGraph();
+}
 
-            int f = b->getFlow();
-            int c = b->getCapacity();
-            int dif = c - f;
-            int d = dif - mean;
+FlowMetrics Manager::getMetrics() const {
+    return pipeTable.getMetrics();
+}
 
-            variance += (d * d);
+void Manager::printMetrics(const string& title, const FlowMetrics& metrics) {
+    cout << endl;
+    cout << title << ":" << endl;
+    cout << "Pipes: " << metrics.count << endl;
+    cout << "Min Flow: " << metrics.minFlow << endl;
+    cout << "Max Flow: " << metrics.maxFlow << endl;
+    cout << "Average Flow: " << metrics.meanFlow << endl;
+    cout << "Variance of the Flow: " << metrics.varianceFlow << endl;
+    cout << "Percentiles of the Flow (50/90/99): " << metrics.medianFlow << " / " << metrics.p90Flow << " / " << metrics.p99Flow << endl;
+    cout << "Min Difference between Flow and Capacity: " << metrics.minSlack << endl;
+    cout << "Max Difference between Flow and Capacity: " << metrics.maxSlack << endl;
+    cout << "Average Difference between Flow and Capacity: " << metrics.meanSlack << endl;
+    cout << "Variance of the difference between Flow and Capacity : " << metrics.varianceSlack << endl;
+    cout << "Percentiles of the difference between Flow and Capacity (50/90/99): " << metrics.medianSlack << " / " << metrics.p90Slack << " / " << metrics.p99Slack << endl;
+}
+
+DemandGrowth Manager::getDemandGrowth() {
+    Vertex* superSource = addSuperSource();
+    Vertex* superSink = addSuperSink();
+    initializeFlows();
+    FlowNetwork network;
+    network.build(graph, superSource, superSink);
+    const int source = network.getSource();
+    const int sink = network.getSink();
+    const int m = network.getNumberOfArcs();
+
+    // Capacity of every arc with a factor of 1, the arcs to the super sink have the demand of their city
+    vector<long long> capacities(m);
+    vector<unsigned char> demandArc(m);
+    for (int a = 0; a < m; a++) {
+        capacities[a] = network.getCapacity(a);
+        demandArc[a] = network.getHead(a) == sink;
+    }
+    vector<int> cityVertex(cityTable.getNumberOfCities());
+    long long totalDemand = 0;
+    for (int i = 0; i < cityTable.getNumberOfCities(); i++) {
+        cityVertex[i] = network.getIndex(cityTable.getCity(i));
+        totalDemand += cityTable.getDemand(i);
+    }
+
+    DemandGrowth growth;
+    vector<unsigned char> sourceSide(network.getNumberOfVertexes(), 0);
+    sourceSide[source] = 1;
+    if (totalDemand > 0) {
+        long long numerator = 0, denominator = totalDemand;
+        for (int a = network.getFirstArc(source); a < network.getEndArc(source); a++) {
+            numerator += capacities[a];
+        }
+        while (true) {
+            const long long divisor = gcd(numerator, denominator);
+            growth.numerator = numerator / divisor;
+            growth.denominator = denominator / divisor;
+            network.clearFlow();
+            for (int a = 0; a < m; a++) {
+                network.setBaseCapacity(a, capacities[a] * (demandArc[a] ? growth.numerator : growth.denominator));
+            }
+            network.takeChangedArcs();
+            if (PushRelabel().solve(network) == growth.numerator * totalDemand) break;
+
+            // The minimum cut gives a smaller factor
+            sourceSide = network.getSourceSide();
+            numerator = 0;
+            denominator = 0;
+            for (int v = 0; v < network.getNumberOfVertexes(); v++) {
+                if (!sourceSide[v]) continue;
+                for (int a = network.getFirstArc(v); a < network.getEndArc(v); a++) {
+                    if (!demandArc[a] && !sourceSide[network.getHead(a)]) numerator += capacities[a];
+                }
+            }
+            for (int i = 0; i < cityTable.getNumberOfCities(); i++) {
+                if (!sourceSide[cityVertex[i]]) denominator += cityTable.getDemand(i);
+            }
         }
-
     }
 
-    metrics.emplace_back(mn);
-    metrics.emplace_back(mx);
-    metrics.emplace_back(sum/n);
-    metrics.emplace_back(mx_dif);
-    metrics.emplace_back(mean);
-    metrics.emplace_back(variance/n);
-
-    return metrics;
+    for (int v = 0; v < network.getNumberOfVertexes(); v++) {
+        if (!sourceSide[v]) continue;
+        for (int a = network.getFirstArc(v); a < network.getEndArc(v); a++) {
+            if (demandArc[a] || sourceSide[network.getHead(a)] || capacities[a] == 0) continue;
+            const string head = Graph::getCode(network.getVertex(network.getHead(a)));
+            // The super source is internal, its edges are the max delivery of their reservoir
+            if (v == source) growth.cut.push_back({head, "(max delivery)", static_cast<int>(capacities[a])});
+            else growth.cut.push_back({Graph::getCode(network.getVertex(v)), head, static_cast<int>(capacities[a])});
+        }
+    }
+    for (int i = 0; i < cityTable.getNumberOfCities(); i++) {
+        if (!sourceSide[cityVertex[i]]) growth.cities.push_back(cityTable.getCode(i));
+    }
+    resetGraph();
+    return growth;
 }
 
+void Manager::writeDemandGrowth(ostream& out, const DemandGrowth& growth) {
+    out << "Factor,Numerator,Denominator" << '\n';
+    if (growth.isUnbounded()) {
+        out << "inf,1,0" << '\n';
+        return;
+    }
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << fixed << setprecision(6) << growth.getFactor() << "," << growth.numerator << "," << growth.denominator << '\n';
+    out.flags(flags);
+    out.precision(precision);
 
+    out << '\n' << "Origin,Destination,Capacity" << '\n';
+    for (const auto& pipe : growth.cut) {
+        out << pipe.origin << "," << pipe.destination << "," << pipe.capacity << '\n';
+    }
+    out << '\n' << "City" << '\n';
+    for (const auto& city : growth.cities) {
+        out << city << '\n';
+    }
+}
 
+vector<PipeUpgrade> Manager::planPipeUpgrades(const long long delta) {
+    maxFlowBaseline();
+    const FlowNetwork& network = bk.getNetwork();
+    vector<PipeUpgrade> upgrades;
+    for (const auto& upgrade : UpgradePlanner().plan(network, delta)) {
+        const int arc = upgrade.arc;
+        PipeUpgrade pipe = {Graph::getCode(network.getVertex(network.getTail(arc))), Graph::getCode(network.getVertex(network.getHead(arc))),
+                            static_cast<int>(network.getBaseCapacity(arc)), upgrade.delta, upgrade.gain, {}};
+        for (const auto& [city, gain] : upgrade.cities) {
+            pipe.cities.emplace_back(Graph::getCode(network.getVertex(city)), gain);
+        }
+        upgrades.push_back(std::move(pipe));
+    }
+    resetGraph();
+    return upgrades;
+}
 
+void Manager::writePipeUpgrades(ostream& out, const vector<PipeUpgrade>& upgrades) {
+    out << "Rank,Origin,Destination,Capacity,Delta,Gain,Cities" << '\n';
+    for (size_t i = 0; i < upgrades.size(); i++) {
+        const auto& upgrade = upgrades[i];
+        out << i + 1 << "," << upgrade.origin << "," << upgrade.destination << "," << upgrade.capacity << "," << upgrade.delta << "," << upgrade.gain << ",";
+        for (size_t c = 0; c < upgrade.cities.size(); c++) {
+            out << (c > 0 ? " " : "") << upgrade.cities[c].first << ":" << upgrade.cities[c].second;
+        }
+        out << '\n';
+    }
+}
 
+long long Manager::countMaxFlow(const bool depthFirst) {
+    counters = SolverCounters();
+    long long total = 0;
+    for (const auto& flow : depthFirst ? maxFlowFordFulkerson() : maxFlowEdmondsKarp()) {
+        total += flow.second;
+    }
+    resetGraph();
+    return total;
+}
+
+void Manager::profileSolvers(ostream& out) {
+    PerfProbe probe;
+    ostringstream rows;
+    rows << "Run,Milliseconds,Cycles,Instructions,CacheMisses,BranchMisses" << '\n';
+    auto measure = [&](const char* name, auto run) {
+        const auto start = chrono::steady_clock::now();
+        probe.start();
+        run();
+        const PerfProbe::Sample sample = probe.stop();
+        const chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        rows << name << "," << fixed << setprecision(3) << elapsed.count() << defaultfloat;
+        PerfProbe::writeFields(rows, sample);
+        rows << '\n';
+    };
+
+    measure("edmonds-karp", [this] { maxFlowEdmondsKarp(); });
+    resetGraph();
+    measure("ford-fulkerson", [this] { maxFlowFordFulkerson(); });
+    resetGraph();
+    measure("boykov-kolmogorov", [this] { maxFlowBoykovKolmogorov(); });
+    resetGraph();
+    measure("push-relabel", [this] { maxFlowPushRelabel(); });
+    resetGraph();
 
+    // The sweeps report every scenario on the console
+    ostringstream discarded;
+    streambuf* console = cout.rdbuf(discarded.rdbuf());
+    measure("reservoir sweep edmonds-karp", [this] { disableEachReservoirEdmondsKarp(); });
+    measure("station sweep boykov-kolmogorov", [this] { disableEachStationBoykovKolmogorov(); });
+    measure("pipe sweep boykov-kolmogorov", [this] { disableEachPipeBoykovKolmogorov(); });
+    cout.rdbuf(console);
+    out << rows.str();
+}
+
+void Manager::writeSolverCounters(ostream& out, const string& engine, const long long flow, const SolverCounters& counters) {
+    out << "{\"engine\":\"" << engine << "\",\"instrumented\":" << (SolverCounters::isEnabled() ? "true" : "false")
+        << ",\"flow\":" << flow
+        << ",\"searches\":" << counters.searches
+        << ",\"augmentingPaths\":" << counters.augmentingPaths
+        << ",\"verticesScanned\":" << counters.verticesScanned
+        << ",\"edgesScanned\":" << counters.edgesScanned
+        << ",\"pathEdges\":" << counters.pathEdges
+        << ",\"longestPath\":" << counters.longestPath
+        << ",\"residualEdges\":" << counters.residualEdges
+        << ",\"resets\":" << counters.resets
+        << ",\"resetNanoseconds\":" << counters.resetNanoseconds << "}" << '\n';
+}
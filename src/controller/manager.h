@@ -8,6 +8,32 @@
 
 // Project headers
 #include "../model/Graph.h"
+#include "../model/AttributionMatrix.h"
+#include "../model/CityTable.h"
+#include "../model/Criticality.h"
+#include "../model/DemandGrowth.h"
+#include "../model/FlowDecomposition.h"
+#include "../model/FlowDiff.h"
+#include "../model/FlowMetrics.h"
+#include "../model/ImportDelta.h"
+#include "../model/MinCut.h"
+#include "../model/PipeTable.h"
+#include "../model/PipeUpgrade.h"
+#include "../model/ReservoirStorage.h"
+#include "../model/SolverCounters.h"
+#include "../model/TimeSeries.h"
+#include "boykovkolmogorov.h"
+#include "csvreader.h"
+#include "dominatortree.h"
+#include "mincostflow.h"
+#include "networkreduction.h"
+#include "perfprobe.h"
+#include "pushrelabel.h"
+#include "regionsolver.h"
+#include "resultwriter.h"
+#include "sweepresults.h"
+#include "tracer.h"
+#include "upgradeplanner.h"
 // Standard library headers
 #include <string>
 #include <unordered_map>
@@ -20,6 +46,8 @@ using namespace std;
 class Manager{
 
     Graph* graph;
+    BoykovKolmogorov bk; /**< Boykov-Kolmogorov engine, kept between solves of a failure sweep. */
+    SolverCounters counters; /**< Work of the path-based solvers, only counted with WATERSUPPLY_INSTRUMENTATION. */
 
     /**
      * @brief Imports the cities from csv
@@ -43,12 +71,66 @@ class Manager{
      * @brief Imports the pipes from csv
      * @param pathPipes Path to the CSV file containing pipe data.
      */
-    void importPipes(const string& pathPipes) const; // Import pipes csv
+    void importPipes(const string& pathPipes); // Import pipes csv
+
+    /**
+     * @brief Creates a city from a row of the cities csv.
+     * @param row The fields of the row.
+     * @return Pointer to the new city.
+     */
+    City* parseCity(const vector<string>& row) const;
+
+    /**
+     * @brief Creates a reservoir from a row of the reservoirs csv.
+     * @param row The fields of the row.
+     * @return Pointer to the new reservoir.
+     */
+    static Reservoir* parseReservoir(const vector<string>& row);
+
+    /**
+     * @brief Creates a station from a row of the stations csv.
+     * @param row The fields of the row.
+     * @return Pointer to the new station.
+     */
+    static Station* parseStation(const vector<string>& row);
+
+    /**
+     * @brief Gets the direction of a row of the pipes csv, terminating the program if it is not 0 or 1.
+     * @param row The fields of the row.
+     * @return 0 for a pipe in one direction, 1 for a pipe in both directions.
+     */
+    static int parseDirection(const vector<string>& row);
+
+    /**
+     * @brief Sets the capacity of an edge and, when there is a baseline flow, of its arc in the Boykov-Kolmogorov engine.
+     *
+     * Time complexity: O(1), or the time of FlowNetwork::setBaseCapacity when there is a baseline flow.
+     *
+     * @param e Pointer to the edge.
+     * @param capacity The new capacity.
+     */
+    void setEdgeCapacity(Edge* e, int capacity);
 
 
     unordered_map<string,Vertex*> stations; /**< Identifier that maps a string to a Station on the graph. */
     unordered_map<string,Vertex*> reservoirs; /**< Identifier that maps a string to a Reservoir on the graph. */
     unordered_map<string,Vertex*> cities; /**< Identifier that maps a string to a City on the graph. */
+    CityTable cityTable; /**< Cities with a dense index, in import order. */
+    PipeTable pipeTable; /**< Pipes with a dense index, in import order. */
+    unordered_map<string,string> names; /**< Name of each city and reservoir already written to a result file. */
+    ResultWriter resultWriter; /**< Writes the result files in the background. */
+    bool verifyRepairs = false; /**< Whether every repaired flow is checked against a solve from scratch. */
+    int repairMismatches = 0; /**< Number of repaired flows that differed from the solve from scratch. */
+
+    /**
+     * @brief Gets the name of a city or reservoir, resolving it only the first time.
+     *
+     * Time complexity: O(1) on average.
+     *
+     * @param code The code of the city or reservoir.
+     * @return The name.
+     */
+    const string& getCachedName(const string& code);
 
     /**
      * @brief Adds the super sink vertex to the graph
@@ -130,10 +212,165 @@ class Manager{
      */
     int findMinEdge(const vector<Edge*>& path);
 
+    /**
+     * @brief Sets the flow of every edge to its capacity before a max-flow, so the flow of an edge is its residual capacity.
+     *
+     * Time complexity: O(V + E), where V is the number of vertices and E is the number of edges in the graph.
+     */
+    void initializeFlows();
+
+    /**
+     * @brief Augments the flow in the graph along the paths found by the given method until there are none left.
+     *
+     * Time complexity: O(P * (V + E)), where P is the number of augmenting paths found.
+     *
+     * @param explore_paths Pointer to the member function used to find augmenting paths (bfs_flow or dfs_flow).
+     * @param superSource Pointer to the super source vertex.
+     * @param superSink Pointer to the super sink vertex.
+     */
+    void augmentFlows(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*), Vertex* superSource, Vertex* superSink);
+
+    /**
+     * @brief Gets the flow that reaches each city in the solved graph, the flow of its edge to the super sink.
+     *
+     * Time complexity: O(V + E), where V is the number of vertices and E is the number of edges in the graph.
+     *
+     * @return A vector of pairs where each pair contains the code of a city and its corresponding flow value.
+     */
+    vector<pair<string,int>> getCityFlows() const;
+
+    /**
+     * @brief Gets the flow that goes through an edge of the solved graph.
+     *
+     * Only pipes and the edges of the super source and super sink carry flow, the residual edges created while augmenting don't.
+     *
+     * Time complexity: O(1)
+     *
+     * @param e Pointer to the edge.
+     * @param superSource Pointer to the super source vertex.
+     * @param superSink Pointer to the super sink vertex.
+     * @return The flow through the edge, negative when the flow goes in the other direction of a two-way pipe.
+     */
+    static int getPipeFlow(const Edge* e, const Vertex* superSource, const Vertex* superSink);
+
+    /**
+     * @brief Gets the flow of every edge of the solved graph that carries some, indexed by vertex.
+     *
+     * Time complexity: O(V + E), where V is the number of vertices and E is the number of edges in the graph.
+     *
+     * @param vertexes The vertices of the graph, the index of a vertex is its position.
+     * @param index Set to the index of each vertex.
+     * @return For each vertex, the index of the destination and the flow of its edges with positive flow.
+     */
+    vector<vector<pair<int,int>>> getFlowAdjacency(const vector<Vertex*>& vertexes, unordered_map<const Vertex*,int>& index) const;
+
+    /**
+     * @brief Cancels the flow that goes around cycles and sorts the vertices topologically.
+     *
+     * A depth-first search follows the edges with flow. When an edge closes a cycle with the search stack, the smallest flow of the cycle is removed from all of its edges, which keeps the flow valid with the same value.
+     *
+     * Time complexity: O(V * E) in the worst case, O(V + E) when there are few cycles.
+     *
+     * @param flows For each vertex, the index of the destination and the flow of its edges, as given by getFlowAdjacency.
+     * @return The vertices in an order where every edge with flow goes forward.
+     */
+    static vector<int> cancelFlowCycles(vector<vector<pair<int,int>>>& flows);
+
+    /**
+     * @brief Splits the flow of the solved graph into weighted paths from a reservoir to a city.
+     *
+     * Paths are followed from the super source over the edges that still have flow not assigned to a path, and each one takes the smallest of those flows. Flow that goes around a cycle doesn't reach any city, so it is cancelled when the walk closes one.
+     *
+     * Time complexity: O(V * E) in the worst case, O(E + L) in practice, where L is the total length of the paths.
+     *
+     * @return The decomposition of the flow, empty if the graph was not solved.
+     */
+    FlowDecomposition decomposeFlow() const;
+
+    /**
+     * @brief Computes how much of the flow that reaches each city comes from each reservoir in the solved graph.
+     *
+     * After cancelling the cycles, the flow that arrives at each vertex is followed in topological order and split among its edges in proportion to their flow, so every city receives the same mix of reservoirs as the water that reaches it.
+     *
+     * Time complexity: O(R * (V + E)) after cancelFlowCycles, where R is the number of reservoirs.
+     *
+     * @return The reservoir x city matrix, with every value 0 if the graph was not solved.
+     */
+    AttributionMatrix attributeFlow() const;
+
+    /**
+     * @brief Removes flow from an edge of the solved graph, updating its reverse edge.
+     *
+     * Time complexity: O(1)
+     *
+     * @param e Pointer to the edge, which must have a reverse edge.
+     * @param amount Amount of flow to remove.
+     */
+    static void cancelFlow(Edge* e, int amount);
+
+    /**
+     * @brief Removes all the flow that goes through some vertices and pipes, keeping a valid flow in the rest of the graph.
+     *
+     * The flow of every edge of the vertices and of the pipes is cancelled. The flow that then arrives at a vertex without leaving it is returned along the flow paths to the super source, and the flow that leaves a vertex without arriving is removed along the flow paths up to the super sink.
+     *
+     * Time complexity: O(V * E) in the worst case, proportional to the flow paths that go through the removed elements in practice.
+     *
+     * @param vertexes The vertices whose flow is removed.
+     * @param pipes The pipes whose flow is removed.
+     */
+    void removeFlow(const vector<Vertex*>& vertexes, const vector<Edge*>& pipes);
+
+    /**
+     * @brief Recomputes the maximum flow of the solved graph after vertices or pipes were disabled.
+     *
+     * The flow that went through the disabled elements is removed with removeFlow and the flow is augmented again from the result, so only the lost flow has to be rerouted. When the repairs are verified, a result that isn't a maximum flow is reported on the error stream and counted in getRepairMismatches.
+     *
+     * Time complexity: O(R + P * (V + E)), where R is the time of removeFlow and P is the number of augmenting paths needed to reroute the flow.
+     *
+     * @param explore_paths Pointer to the member function used to find augmenting paths (bfs_flow or dfs_flow).
+     * @param codes The codes of the disabled vertices.
+     * @param pipes The disabled pipes.
+     * @return A vector of pairs where each pair contains the code of a city and its corresponding flow value in the maximum flow.
+     */
+    vector<pair<string,int>> repairMaxFlow(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*), const vector<string>& codes, const vector<Edge*>& pipes);
+
+    /**
+     * @brief Checks that the total of some city flows is the maximum flow of the graph, with its disabled elements.
+     *
+     * The maximum flow is solved from scratch with push-relabel on a separate network, so the flow of the graph is left untouched.
+     *
+     * Time complexity: O(V + E) plus the time of PushRelabel::solve.
+     *
+     * @param flows The flows of the cities.
+     * @return True if the total of the flows is the maximum flow, false otherwise.
+     */
+    bool isMaxFlow(const vector<pair<string,int>>& flows) const;
+
+    /**
+     * @brief Augments the flow of the solved graph again after disabled vertices or pipes were enabled.
+     *
+     * Only the flow that the enabled elements can carry is added, so the graph gets back a maximum flow of the whole network without solving it from scratch.
+     *
+     * Time complexity: O(P * (V + E)), where P is the number of augmenting paths found.
+     *
+     * @param explore_paths Pointer to the member function used to find augmenting paths (bfs_flow or dfs_flow).
+     */
+    void restoreMaxFlow(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*));
+
+    /**
+     * @brief Gets the flow that reaches each city in a solved network.
+     *
+     * Time complexity: O(V + E), where V is the number of vertices and E is the number of arcs in the network.
+     *
+     * @param network The solved network.
+     * @return A vector of pairs where each pair contains the code of a city and its corresponding flow value, in the same order as maxFlow.
+     */
+    vector<pair<string,int>> getCityFlows(const FlowNetwork& network) const;
+
     /**
      * @brief Finds the maximum flow in the graph using a specified flow path exploration method.
      *
-     * This function calculates the maximum flow in the graph using a specified method for exploring flow paths. It first adds a super source and a super sink to the graph, initializes flow values on edges, and then iteratively explores flow paths using the specified method until no more flow paths can be found. The function returns a vector of pairs containing the code of each city and its corresponding flow value in the maximum flow.
+     * This function calculates the maximum flow in the graph using a specified method for exploring flow paths. It first adds a super source and a super sink to the graph, initializes flow values on edges, and then augments the flow with augmentFlows until no more flow paths can be found. The function returns a vector of pairs containing the code of each city and its corresponding flow value in the maximum flow.
      *
      * Time complexity: O(V + E), where V is the number of vertices and E is the number of edges in the graph.
      *
@@ -164,6 +401,39 @@ class Manager{
      */
     vector<pair<string,int>> maxFlowFordFulkerson();
 
+    /**
+     * @brief Finds the maximum flow in the graph using the Boykov-Kolmogorov algorithm.
+     *
+     * This function builds the Boykov-Kolmogorov engine from the graph, computes the maximum flow and writes the flows back to the graph. The engine keeps its search trees and its flow until the graph is reset, so later calls to solveBoykovKolmogorov only repair the elements marked dirty by disableStations, disablePipes and disableReservoirs.
+     *
+     * Time complexity: O(V * E^2 * |C|) in the worst case, where |C| is the capacity of the minimum cut, close to linear in practice.
+     *
+     * @return A vector of pairs where each pair contains the code of a city and its corresponding flow value in the maximum flow.
+     */
+    vector<pair<string,int>> maxFlowBoykovKolmogorov();
+
+    /**
+     * @brief Finds the maximum flow in the graph using the parallel push-relabel algorithm.
+     *
+     * This function builds a compact network from the graph, reduces its series and parallel pipes, computes the maximum flow of the reduced network with the multithreaded push-relabel engine, solving independent supply regions on separate threads, and writes the flows, expanded to every pipe, back to the graph. The total flow is the same as the one of maxFlowEdmondsKarp, but when several maximum flows exist the split between the cities may differ.
+     *
+     * Time complexity: O(V^2 * E) in the worst case, close to linear in practice and spread over the hardware threads.
+     *
+     * @return A vector of pairs where each pair contains the code of a city and its corresponding flow value in the maximum flow.
+     */
+    vector<pair<string,int>> maxFlowPushRelabel();
+
+    /**
+     * @brief Recomputes the maximum flow with the Boykov-Kolmogorov engine after elements were marked dirty.
+     *
+     * The flows are not written back to the graph.
+     *
+     * Time complexity: proportional to the regions of the search trees affected by the dirty elements.
+     *
+     * @return A vector of pairs where each pair contains the code of a city and its corresponding flow value in the maximum flow.
+     */
+    vector<pair<string,int>> solveBoykovKolmogorov();
+
     /**
      * @brief Creates a CSV file containing flow information.
      *
@@ -224,6 +494,77 @@ class Manager{
      */
     void createCsvFileRates(const string& path,vector<pair<string,double>>& rates);
 
+    /**
+     * @brief Creates a CSV file containing the paths of a flow decomposition.
+     *
+     * Time complexity: O(L), where L is the total length of the paths.
+     *
+     * @param path The file path where the CSV file will be created.
+     * @param decomposition The decomposition of the flow.
+     */
+    void createCsvFileFlowPaths(const string& path, const FlowDecomposition& decomposition);
+
+    /**
+     * @brief Prints the paths of a flow decomposition and generates a CSV file with them.
+     *
+     * Time complexity: O(L), where L is the total length of the paths.
+     *
+     * @param decomposition The decomposition of the flow.
+     * @param outputFile The path to the output CSV file.
+     */
+    void printFlowPaths(const FlowDecomposition& decomposition, const string& outputFile);
+
+    /**
+     * @brief Creates a CSV file containing the flow each city receives from each reservoir.
+     *
+     * Time complexity: O(R * C), where R is the number of reservoirs and C the number of cities.
+     *
+     * @param path The file path where the CSV file will be created.
+     * @param matrix The attribution matrix.
+     */
+    void createCsvFileAttribution(const string& path, const AttributionMatrix& matrix);
+
+    /**
+     * @brief Creates a CSV file containing the demand, flow and deficit of every city.
+     *
+     * Time complexity: O(C), where C is the number of cities.
+     *
+     * @param path The file path where the CSV file will be created.
+     * @param supplied The flow supplied to each city, indexed as in the city table.
+     * @param deficits The deficit of each city, indexed as in the city table.
+     */
+    void createCsvFileDeficits(const string& path, const vector<int>& supplied, const vector<int>& deficits);
+
+    /**
+     * @brief Creates a CSV file containing the pipes of a minimum cut and the cities behind each one.
+     *
+     * Time complexity: O(P * C), where P is the number of pipes of the cut and C the number of cities.
+     *
+     * @param path The file path where the CSV file will be created.
+     * @param cut The minimum cut.
+     */
+    void createCsvFileMinCut(const string& path, const MinCut& cut);
+
+    /**
+     * @brief Creates a CSV file containing the stations and pipes that cut cities off.
+     *
+     * Time complexity: O(S * C), where S is the number of stations and pipes and C the number of cities.
+     *
+     * @param path The file path where the CSV file will be created.
+     * @param criticality The stations and pipes that cut cities off.
+     */
+    void createCsvFileCriticality(const string& path, const Criticality& criticality);
+
+    /**
+     * @brief Prints the reservoirs that supply each city and generates a CSV file with them.
+     *
+     * Time complexity: O(R * C), where R is the number of reservoirs and C the number of cities.
+     *
+     * @param matrix The attribution matrix.
+     * @param outputFile The path to the output CSV file.
+     */
+    void printAttribution(const AttributionMatrix& matrix, const string& outputFile);
+
     /**
      * @brief Calculates flow rates for cities based on the provided flows and generates a CSV file.
      *
@@ -273,6 +614,17 @@ class Manager{
      */
     void disableStations(vector<string>& stations);
 
+    /**
+     * @brief Enables stations with the given codes.
+     *
+     * This function enables the stations again after disableStations, marking them dirty in the Boykov-Kolmogorov engine.
+     *
+     * Time complexity: O(n), where n is the number of station codes in the stations vector.
+     *
+     * @param stations A vector containing the codes of the stations to be enabled.
+     */
+    void enableStations(vector<string>& stations);
+
     /**
      * @brief Disables the specified pipes.
      *
@@ -284,6 +636,17 @@ class Manager{
      */
     void disablePipes(vector<Edge*>& pipes);
 
+    /**
+     * @brief Enables the specified pipes.
+     *
+     * This function enables the pipes again after disablePipes, marking them dirty in the Boykov-Kolmogorov engine.
+     *
+     * Time complexity: O(n), where n is the number of pipes in the pipes vector.
+     *
+     * @param pipes A vector containing pointers to the pipes to be enabled.
+     */
+    void enablePipes(vector<Edge*>& pipes);
+
     /**
      * @brief Disables reservoirs with the given codes.
      *
@@ -294,76 +657,177 @@ class Manager{
      * @param reservoirs A vector containing the codes of the reservoirs to be disabled.
      */
     void disableReservoirs(vector<string>& reservoirs);
-    void dfs_disable(Vertex* reservoir,int flowToRemove);
+
+    /**
+     * @brief Enables reservoirs with the given codes.
+     *
+     * Time complexity: O(n), where n is the number of reservoir codes in the reservoirs vector.
+     *
+     * @param reservoirs A vector containing the codes of the reservoirs to be enabled.
+     */
+    void enableReservoirs(vector<string>& reservoirs);
 
     /**
      * @brief Shuts down reservoirs and checks the impact on network flow.
      *
-     * This function shuts down the reservoirs specified in the `reservoirs` vector and checks the impact on the network flow using the specified flow calculation function.
+     * The graph must hold the maximum flow of the whole network. The reservoirs are disabled, the flow is repaired incrementally with repairMaxFlow and the reservoirs are enabled again with restoreMaxFlow, so the graph is left with a maximum flow for the next scenario.
      *
-     * Time complexity: O(f + n + m), where f is the time complexity of the specified flow calculation function, n is the number of cities, and m is the number of reservoirs.
+     * Time complexity: O(r + n), where r is the time of repairMaxFlow and of restoring the flow, and n is the number of cities.
      *
-     * @param flowfunction A pointer to a member function of the Manager class that calculates network flow.
+     * @param explore_paths Pointer to the member function used to find augmenting paths (bfs_flow or dfs_flow).
+     * @param beforeFlows The flows of the cities before shutting down the reservoirs.
      * @param reservoirs A vector containing the codes of the reservoirs to be shut down.
+     * @param sweep Sweep file that gets the comparison of every city and the statistics of the flow of the pipes after the scenario, or nullptr.
      * @return True if the network flow remains unaffected after shutting down the reservoirs, false otherwise.
      */
-    bool shutdownReservoirs(vector<pair<string,int>> (Manager::*flowfunction)(),vector<string>& reservoirs);
-    vector<pair<string,double>> shutdownReservoirsWithDecrease(vector<pair<string,int>> (Manager::*flowfunction)(),vector<string>& reservoirs);
+    bool shutdownReservoirs(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*),const vector<pair<string,int>>& beforeFlows,vector<string>& reservoirs,SweepWriter* sweep = nullptr);
+
+    /**
+     * @brief Shuts down reservoirs and calculates the percentage decrease in flow for each city.
+     *
+     * The graph must hold the maximum flow of the whole network. The reservoirs are shut down, the flow is repaired incrementally with repairMaxFlow and restored with restoreMaxFlow, and the percentage decrease in flow is calculated for each city.
+     *
+     * Time complexity: O(r + n), where r is the time of repairMaxFlow and of restoring the flow, and n is the number of cities.
+     *
+     * @param explore_paths Pointer to the member function used to find augmenting paths (bfs_flow or dfs_flow).
+     * @param beforeFlows The flows of the cities before shutting down the reservoirs.
+     * @param reservoirs A vector containing the codes of the reservoirs to be shut down.
+     * @return A vector of pairs containing the city code and the percentage decrease in flow for each city.
+     */
+    vector<pair<string,double>> shutdownReservoirsWithDecrease(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*),const vector<pair<string,int>>& beforeFlows,vector<string>& reservoirs);
+
+    /**
+     * @brief Prints the percentage decline in flow of each city after shutting down pipes.
+     *
+     * Time complexity: O(n), where n is the number of cities.
+     *
+     * @param flows The flow of each city before the pipes were shut down.
+     * @param diff The comparison of the flows before and after shutting down the pipes.
+     */
+    static void printPipeDecline(const vector<pair<string,int>>& flows, const FlowDiff& diff);
 
     /**
      * @brief Shuts down pipes and checks the impact on network flow.
      *
-     * This function shuts down the specified pipes and checks the impact on the network flow using the specified  flow calculation function.
+     * The graph must hold the maximum flow of the whole network. The pipes are disabled, the flow is repaired incrementally with repairMaxFlow and the pipes are enabled again with restoreMaxFlow, so the graph is left with a maximum flow for the next scenario.
      *
-     * Time complexity: O(f + m + n), where f is the time complexity of the specified flow calculation function, m is the number of pipes, and n is the number of cities.
+     * Time complexity: O(r + n), where r is the time of repairMaxFlow and of restoring the flow, and n is the number of cities.
      *
-     * @param flowfunction A pointer to a member function of the Manager class that calculates network flow.
+     * @param explore_paths Pointer to the member function used to find augmenting paths (bfs_flow or dfs_flow).
+     * @param beforeFlows The flows of the cities before shutting down the pipes.
      * @param pipes A vector containing pointers to the edges (pipes) to be shut down.
+     * @param sweep Sweep file that gets the comparison of every city and the statistics of the flow of the pipes after the scenario, or nullptr.
      * @return True if the network flow remains unaffected after shutting down the pipes, false otherwise.
      */
-    bool shutdownPipes(vector<pair<string,int>> (Manager::*flowfunction)(),vector<Edge*>& pipes);
+    bool shutdownPipes(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*),const vector<pair<string,int>>& beforeFlows,vector<Edge*>& pipes,SweepWriter* sweep = nullptr);
 
     /**
      * @brief Shuts down stations and checks the impact on network flow.
      *
-     * This function shuts down the specified stations and checks the impact on the network flow using the specified  flow calculation function.
+     * The graph must hold the maximum flow of the whole network. The stations are disabled, the flow is repaired incrementally with repairMaxFlow and the stations are enabled again with restoreMaxFlow, so the graph is left with a maximum flow for the next scenario.
+     *
+     * Time complexity: O(r + n), where r is the time of repairMaxFlow and of restoring the flow, and n is the number of cities.
+     *
+     * @param explore_paths Pointer to the member function used to find augmenting paths (bfs_flow or dfs_flow).
+     * @param beforeFlows The flows of the cities before shutting down the stations.
+     * @param stations A vector containing the codes of stations to be shut down.
+     * @param sweep Sweep file that gets the comparison of every city and the statistics of the flow of the pipes after the scenario, or nullptr.
+     * @return True if the network flow remains unaffected after shutting down the stations, false otherwise.
+     */
+    bool shutdownStations(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*),const vector<pair<string,int>>& beforeFlows,vector<string>& stations,SweepWriter* sweep = nullptr);
+
+    /**
+     * @brief Shuts down stations on the solved Boykov-Kolmogorov engine and checks the impact on network flow.
+     *
+     * The stations are disabled, the flow is repaired incrementally and the stations are enabled again, so the next scenario only repairs the changes of both.
      *
-     * Time complexity: O(f + s + n), where f is the time complexity of the specified flow calculation function, s is the number of stations, and n is the number of cities.
+     * Time complexity: O(r + n), where r is the time of the incremental repair and n is the number of cities.
      *
-     * @param function A pointer to a member function of the Manager class that calculates network flow.
+     * @param beforeFlows The flows of the cities before shutting down the stations.
      * @param stations A vector containing the codes of stations to be shut down.
+     * @param sweep Sweep file that gets the comparison of every city and the statistics of the flow of the pipes after the scenario, or nullptr.
      * @return True if the network flow remains unaffected after shutting down the stations, false otherwise.
      */
-    bool shutdownStations(vector<pair<string,int>> (Manager::*function)(),vector<string>& stations);
+    bool shutdownStationsBoykovKolmogorov(const vector<pair<string,int>>& beforeFlows,vector<string>& stations,SweepWriter* sweep = nullptr);
 
+    /**
+     * @brief Records a station on no route from a reservoir to a city as not affecting the network, without solving.
+     *
+     * No water can reach a city through the station, so the flows of the cities stay the same without it.
+     *
+     * Time complexity: O(n), where n is the number of cities.
+     *
+     * @param beforeFlows The flows of the cities with the station.
+     * @param beforeMetrics The statistics of the flow of the pipes with the station.
+     * @param stations A vector containing the code of the station.
+     * @param sweep Sweep file that gets the comparison of every city and the statistics of the flow of the pipes after the scenario, or nullptr.
+     * @return True, the network is never affected.
+     */
+    bool shutdownIdleStation(const vector<pair<string,int>>& beforeFlows,const FlowMetrics& beforeMetrics,vector<string>& stations,SweepWriter* sweep = nullptr);
+
+    /**
+     * @brief Shuts down pipes on the solved Boykov-Kolmogorov engine and checks the impact on network flow.
+     *
+     * Time complexity: O(r + n), where r is the time of the incremental repair and n is the number of cities.
+     *
+     * @param beforeFlows The flows of the cities before shutting down the pipes.
+     * @param pipes A vector containing pointers to the edges (pipes) to be shut down.
+     * @param sweep Sweep file that gets the comparison of every city and the statistics of the flow of the pipes after the scenario, or nullptr.
+     * @return True if the network flow remains unaffected after shutting down the pipes, false otherwise.
+     */
+    bool shutdownPipesBoykovKolmogorov(const vector<pair<string,int>>& beforeFlows,vector<Edge*>& pipes,SweepWriter* sweep = nullptr);
 
-    vector<pair<string,int>> graphChangeFlowsAfterReservoirsDisabled(vector<string>& reservoirs);
 
     /**
      * @brief Shuts down pipes and calculates the percentage decrease in flow for each city.
      *
-     * This function shuts down the specified pipes and calculates the percentage decrease in flow for each city  using the specified flow calculation function.
+     * The graph must hold the maximum flow of the whole network. The pipes are shut down, the flow is repaired incrementally with repairMaxFlow and restored with restoreMaxFlow, and the percentage decrease in flow is calculated for each city.
      *
-     * Time complexity: O(f + p + n), where f is the time complexity of the specified flow calculation function, p is the number of pipes, and n is the number of cities.
+     * Time complexity: O(r + n), where r is the time of repairMaxFlow and of restoring the flow, and n is the number of cities.
      *
-     * @param flowfunction A pointer to a member function of the Manager class that calculates network flow.
+     * @param explore_paths Pointer to the member function used to find augmenting paths (bfs_flow or dfs_flow).
+     * @param beforeFlows The flows of the cities before shutting down the pipes.
      * @param pipes A vector containing pointers to the pipes to be shut down.
      * @return A vector of pairs containing the city code and the percentage decrease in flow for each city.
      */
-    vector<pair<string,double>> shutdownPipesWithDecrease(vector<pair<string,int>> (Manager::*flowfunction)(),vector<Edge*>& pipes);
+    vector<pair<string,double>> shutdownPipesWithDecrease(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*),const vector<pair<string,int>>& beforeFlows,vector<Edge*>& pipes);
 
     /**
      * @brief Determines if each city can get enough water based on provided flow data.
      *
-     * This function determines if each city in the provided list of city codes can get enough water  based on the flow data provided. It compares the flow data with the demand for each city and  returns a vector of pairs indicating whether each city can get enough water.
+     * This function determines if each city in the provided list of city codes can get enough water based on the flow supplied to it. The deficits of every city are computed at once with CityTable::computeDeficits and the selected cities are reported in import order, followed by their total deficit.
      *
-     * Time complexity: O(m), where m is the number of flow data entries.
+     * Time complexity: O(C + m), where C is the number of cities and m is the number of codes.
      *
      * @param codes A vector containing the codes of the cities to be checked.
-     * @param flows A vector containing pairs of city codes and corresponding flow data.
+     * @param supplied The flow supplied to each city, indexed as in the city table.
      * @return A vector of pairs containing the city code and a boolean indicating if the city can get enough water.
      */
-    vector<pair<string,bool>> canCityGetEnoughWater(vector<string>& codes,vector<pair<string,int>>& flows);
+    vector<pair<string,bool>> canCityGetEnoughWater(const vector<string>& codes, const vector<int>& supplied) const;
+
+    /**
+     * @brief Prints the pipes of a minimum cut with the cities behind each one and generates a CSV file with them.
+     *
+     * Time complexity: O(P * C), where P is the number of pipes of the cut and C the number of cities.
+     *
+     * @param cut The minimum cut.
+     * @param outputFile The path to the output CSV file.
+     */
+    void printMinCut(const MinCut& cut, const string& outputFile);
+
+    /**
+     * @brief Reads the steps of a time series.
+     *
+     * Prints an error and terminates the program if a row doesn't have a value for every column.
+     *
+     * Time complexity: O(S * K), where S is the number of steps and K the number of columns.
+     *
+     * @param reader The reader of the file, after the header.
+     * @param columns The index of the vertex of each column.
+     * @param name The name of the file, for the errors.
+     * @return The time series.
+     */
+    TimeSeries importTimeSeries(CsvReader& reader, vector<int> columns, const string& name) const;
 
 public:
     /**
@@ -403,6 +867,152 @@ public:
      */
     void importFiles(const string& pathCities,const string& pathReservoirs,const string& pathStations,const string& pathPipes);
 
+    /**
+     * @brief Imports the data set files again, applying only what changed since they were loaded.
+     *
+     * The files are compared with the network: new demands, max deliveries and pipe capacities are set in place and,
+     * if there is a baseline flow, passed to the Boykov-Kolmogorov engine, so the next call to maxFlowBaseline only
+     * repairs the flow around them. Added, removed or otherwise changed cities, reservoirs, stations and pipes are
+     * structural changes, and the files are imported again with importFiles, dropping the baseline flow.
+     *
+     * Time complexity: O(V + E) to parse and compare the files, plus the time of importFiles for structural changes.
+     *
+     * @param pathCities The path to the file containing city data.
+     * @param pathReservoirs The path to the file containing reservoir data.
+     * @param pathStations The path to the file containing station data.
+     * @param pathPipes The path to the file containing pipe data.
+     * @return The differences found.
+     */
+    ImportDelta reimportFiles(const string& pathCities,const string& pathReservoirs,const string& pathStations,const string& pathPipes);
+
+    /**
+     * @brief Computes the maximum flow with Boykov-Kolmogorov, keeping it as the baseline flow.
+     *
+     * The first call solves the network from scratch, the next ones repair the baseline flow after changes applied by
+     * reimportFiles. The baseline flow is dropped by resetGraph.
+     *
+     * Time complexity: O(V * E^2 * |C|) for the first call, proportional to the regions affected by the changes after.
+     *
+     * @return A vector of pairs where each pair contains the code of a city and its corresponding flow value in the maximum flow.
+     */
+    vector<pair<string,int>> maxFlowBaseline();
+
+    /**
+     * @brief Finds the minimum cut of the maximum flow in the graph.
+     *
+     * The source side of the cut is what the super source reaches through edges with residual capacity, so the
+     * saturated pipes from it to the other vertexes separate the reservoirs from the cities that don't get enough
+     * water. The cities behind each pipe are the ones whose water crosses it in the decomposition of the flow into
+     * paths, and the edges from the super source are reported as the max delivery of their reservoir.
+     *
+     * Time complexity: O(V * E) for the decomposition, plus O(P * A) for the cities, where P is the number of pipes of
+     * the cut and A the total length of the paths.
+     *
+     * @return The minimum cut.
+     */
+    MinCut getMinCut();
+
+    /**
+     * @brief Writes the pipes of a minimum cut and the cities behind each one in CSV format.
+     *
+     * Each line has a pipe, its capacity, and one of the cities behind it with its deficit. Pipes without cities
+     * behind them have a line with the city and deficit empty.
+     *
+     * Time complexity: O(P * C), where P is the number of pipes of the cut and C the number of cities.
+     *
+     * @param out The stream to write to.
+     * @param cut The minimum cut.
+     */
+    static void writeMinCut(ostream& out, const MinCut& cut);
+
+    /**
+     * @brief Writes the flow and the deficit of every city in the baseline flow to result files.
+     *
+     * The files are "<name>_flows" and "<name>_deficits", written by the result writer; each one replaces the previous
+     * version at once, so they can be read while they are refreshed.
+     *
+     * Time complexity: O(C), where C is the number of cities.
+     *
+     * @param flows The flow of each city, as returned by maxFlowBaseline.
+     * @param name The name of the results.
+     * @return The total deficit.
+     */
+    long long writeBaselineResults(vector<pair<string,int>>& flows, const string& name);
+
+    /**
+     * @brief Imports a demand profile.
+     *
+     * The header has the name of the step column followed by the codes of the cities in the profile, and each row
+     * has the label of a step followed by the demand of those cities. Prints an error and terminates the program if a
+     * city doesn't exist or a row doesn't have a demand for every city.
+     *
+     * Time complexity: O(S * K), where S is the number of steps and K the number of cities in the profile.
+     *
+     * @param path The path to the file containing the profile.
+     * @return The profile.
+     */
+    TimeSeries importDemandProfile(const string& path) const;
+
+    /**
+     * @brief Computes the maximum flow at every step of a demand profile and writes the deficits in CSV format.
+     *
+     * The steps only change the capacities of the edges from the cities to the super sink, so the flow of each step
+     * is repaired from the flow of the previous one by the Boykov-Kolmogorov engine instead of being solved again.
+     * Each row has the label of the step, the total demand, flow and deficit, and the deficit of every city, and is
+     * written as soon as the step is solved. The demands of the city table are restored after the last step.
+     *
+     * Time complexity: O(V * E^2 * |C|) for the baseline flow, then proportional to the changes of each step.
+     *
+     * @param profile The demand profile.
+     * @param out The stream to write to.
+     */
+    void simulateDemandProfile(const TimeSeries& profile, ostream& out);
+
+    /**
+     * @brief Imports the volume and capacity of the reservoirs whose storage is simulated.
+     *
+     * Each row has the code of a reservoir, its initial volume and its capacity. Prints an error and terminates the
+     * program if a reservoir doesn't exist, is repeated, or its volume is not between 0 and its capacity.
+     *
+     * Time complexity: O(R), where R is the number of rows.
+     *
+     * @param path The path to the file containing the storage.
+     * @return The storage of the reservoirs.
+     */
+    ReservoirStorage importReservoirStorage(const string& path) const;
+
+    /**
+     * @brief Imports the inflows of the reservoirs whose storage is simulated.
+     *
+     * The header has the name of the step column followed by the codes of the reservoirs, and each row has the label
+     * of a step followed by the inflow of those reservoirs. Reservoirs without a column have no inflow.
+     *
+     * Time complexity: O(S * K), where S is the number of steps and K the number of reservoirs in the file.
+     *
+     * @param path The path to the file containing the inflows.
+     * @param storage The storage of the reservoirs.
+     * @return The inflows.
+     */
+    TimeSeries importInflows(const string& path, const ReservoirStorage& storage) const;
+
+    /**
+     * @brief Simulates the storage of the reservoirs over the steps of inflow scenarios and writes the result in CSV format.
+     *
+     * In each step the capacity of the edge from the super source to every reservoir in the storage is set to what
+     * the reservoir can deliver, the maximum flow is computed and the volume of the reservoirs is updated with what
+     * they delivered. Only those capacities change, so the flow of each step, and of the first step of each scenario,
+     * is repaired from the flow of the previous one by the Boykov-Kolmogorov engine instead of being solved again.
+     * Every scenario starts from the initial volumes. Each row has the scenario, the label of the step, the total
+     * demand, flow and deficit, and the volume of every reservoir at the end of the step.
+     *
+     * Time complexity: O(V * E^2 * |C|) for the baseline flow, then proportional to the changes of each step.
+     *
+     * @param storage The storage of the reservoirs.
+     * @param scenarios The paths of the files with the inflows of each scenario.
+     * @param out The stream to write to.
+     */
+    void simulateStorage(ReservoirStorage& storage, const vector<string>& scenarios, ostream& out);
+
     /**
      * @brief Resets the graph and its properties.
      *
@@ -417,6 +1027,42 @@ public:
      */
     void resetManager();
 
+    /**
+     * @brief Gets the writer of the result files, to change their directory and names or wait for them to be written.
+     * @return Reference to the writer.
+     */
+    ResultWriter& getResultWriter() { return resultWriter; }
+
+    /**
+     * @brief Sets whether every flow repaired in the failure sweeps is checked against a solve from scratch.
+     * @param verify True to check the repaired flows.
+     */
+    void setVerifyRepairs(bool verify) { verifyRepairs = verify; }
+
+    /**
+     * @brief Gets the number of repaired flows that weren't a maximum flow, counted while the repairs are verified.
+     * @return The number of mismatches.
+     */
+    int getRepairMismatches() const { return repairMismatches; }
+
+    /**
+     * @brief Gets the work counted in maxFlow, bfs_flow, dfs_helper and resetGraph since the counters were cleared.
+     * @return The counters, always zero in builds without WATERSUPPLY_INSTRUMENTATION.
+     */
+    const SolverCounters& getSolverCounters() const { return counters; }
+
+    /**
+     * @brief Clears the solver counters, computes the maximum flow with a path-based solver and resets the graph.
+     *
+     * The work of the solve and of the reset is then given by getSolverCounters.
+     *
+     * Time complexity: Same as maxFlowFordFulkerson or maxFlowEdmondsKarp.
+     *
+     * @param depthFirst True to use Ford-Fulkerson (depth-first searches), false to use Edmonds-Karp.
+     * @return The total flow.
+     */
+    long long countMaxFlow(bool depthFirst);
+
     /**
      * @brief Get the unordered map of stations.
      *
@@ -484,6 +1130,17 @@ public:
      */
     void getFordFulkersonXCity(vector<string>& cities);
 
+    /**
+     * @brief Computes the maximum flow using the parallel push-relabel algorithm for the specified cities.
+     *
+     * This function calculates the maximum flow with the multithreaded push-relabel engine and prints the flow metrics of the given cities to a CSV file.
+     *
+     * Time complexity: O(V^2 * E) in the worst case.
+     *
+     * @param cities A vector of strings representing the codes of cities for which the maximum flow is to be calculated.
+     */
+    void getPushRelabelXCity(vector<string>& cities);
+
     /**
      * @brief Run the Edmonds-Karp algorithm to find maximum flow for all cities.
      *
@@ -506,6 +1163,17 @@ public:
      */
     void getFordFulkersonAllCities(bool reset = true);
 
+    /**
+     * @brief Run the parallel push-relabel algorithm to find maximum flow for all cities.
+     *
+     * This function runs the multithreaded push-relabel engine to find the maximum flow for all cities in the network. It optionally resets the graph after computation and saves the results to a CSV file.
+     *
+     * Time complexity: O(V^2 * E) in the worst case.
+     *
+     * @param reset Flag indicating whether to reset the graph after computation. Default is true.
+     */
+    void getPushRelabelAllCities(bool reset = true);
+
     /* Exercise 2.2 */
 
     /**
@@ -548,12 +1216,19 @@ public:
     void canAllCitiesGetEnoughWaterFF();
 
     /* Exercise 2.3 */
-    void improvePipesHeuristic();
+    /**
+     * @brief Balance the flow over the pipes with a min-cost max-flow and compare the metrics with the current maximum flow.
+     *
+     * The graph must be solved with a maximum flow, which is the control case. The maximum flow is computed again with MinCostFlow, whose cost grows with the utilization of each pipe, so the result has the same total flow and is spread as evenly as possible over the pipes. The metrics of both flows are printed and the graph is reset.
+     *
+     * Time complexity: O(P * (S * E) * log(V)), where P is the number of augmenting paths and S the number of cost segments of a pipe.
+     */
+    void improvePipesMinCost();
     /* Exercise 3.1 */
     /**
      * @brief Disable each reservoir and check if it affects the network flow using Edmonds-Karp algorithm.
      *
-     * This function disables each reservoir in the network one by one and checks if it affects the network flow using the Edmonds-Karp algorithm. It creates a CSV file with the results indicating whether each reservoir can be disabled without affecting the flow.
+     * This function solves the network once with the Edmonds-Karp algorithm and then disables each reservoir one by one, repairing the flow from the solved network to check if it affects the network flow. It creates a CSV file with the results indicating whether each reservoir can be disabled without affecting the flow.
      *
      * Time complexity: O(VE^2).
      */
@@ -567,7 +1242,7 @@ public:
     /**
      * @brief Disable each station individually and measure network impact using Edmonds-Karp algorithm.
      *
-     * This function iterates over each station in the network, disables it, and calculates the maximum flow in the network using the Edmonds-Karp algorithm. It then records whether the network was affected by the station's disablement and saves the results to a CSV file.
+     * This function solves the network once with the Edmonds-Karp algorithm and then, for each station, disables it and repairs the flow from the solved network. It then records whether the network was affected by the station's disablement and saves the results to a CSV file.
      *
      * Time complexity: O(n * f(n)).
      */
@@ -576,12 +1251,53 @@ public:
     /**
      * @brief Disable each station individually and measure network impact using Ford-Fulkerson algorithm.
      *
-     * This function iterates over each station in the network, disables it, and calculates the maximum flow in the network using the Ford-Fulkerson algorithm. It then records whether the network was affected by the station's disablement and saves the results to a CSV file.
+     * This function solves the network once with the Ford-Fulkerson algorithm and then, for each station, disables it and repairs the flow from the solved network. It then records whether the network was affected by the station's disablement and saves the results to a CSV file.
      *
      * Time complexity: O(n * f(n)).
      */
     void disableEachStationFordFulkerson();
 
+    /**
+     * @brief Disable each station individually and measure network impact using the Boykov-Kolmogorov engine.
+     *
+     * This function solves the network once and then, for each station, disables it, repairs the flow from the previous scenario and records whether the network was affected. It saves the results to a CSV file.
+     *
+     * Time complexity: O(f(n) + n * r), where r is the time of an incremental repair.
+     */
+    void disableEachStationBoykovKolmogorov();
+
+    /**
+     * @brief Finds the stations and pipes whose removal alone cuts cities off from every reservoir.
+     *
+     * The network gets a root linked to every reservoir and a vertex in the middle of every pipe, shared by both
+     * directions of a two-way pipe, and a station or pipe cuts a city off when it dominates the city in the dominator
+     * tree from the root. Only the topology is used, so nothing is solved and the graph is not changed.
+     *
+     * Time complexity: O((V + E) * log(V) + C * D), where C is the number of cities and D the depth of the tree.
+     *
+     * @return The stations and pipes that cut cities off, the stations on no route and the cities no reservoir reaches.
+     */
+    Criticality getCriticality() const;
+
+    /**
+     * @brief Writes the stations and pipes that cut cities off in CSV format, followed by the stations on no route
+     * and the cities no reservoir reaches.
+     *
+     * Time complexity: O(S * C), where S is the number of stations and pipes and C the number of cities.
+     *
+     * @param out The stream to write to.
+     * @param criticality The stations and pipes that cut cities off.
+     */
+    static void writeCriticality(ostream& out, const Criticality& criticality);
+
+    /**
+     * @brief Prints the stations and pipes that cut cities off and generates a CSV file with them.
+     *
+     * Time complexity: O((V + E) * log(V) + S * C), where S is the number of stations and pipes and C the number of
+     * cities.
+     */
+    void criticalElements();
+
     /**
      * @brief Disable selected stations and measure the decrease in flow rates using the Edmonds-Karp algorithm.
      *
@@ -607,22 +1323,23 @@ public:
     /**
      * @brief Shutdown selected stations and measure the decrease in flow rates.
      *
-     * This function takes a flow calculation function pointer and a vector of station codes, shuts down each selected station individually, calculates the decrease in flow rates for each city, and returns the results as a vector of pairs containing the city code and the percentage decrease in flow rate.
+     * The graph must hold the maximum flow of the whole network. The selected stations are shut down, the flow is repaired incrementally with repairMaxFlow and restored with restoreMaxFlow, and the decrease in flow rate of each city is returned as a vector of pairs containing the city code and the percentage decrease in flow rate.
      *
-     * Time complexity: O(n^2).
+     * Time complexity: O(r + n), where r is the time of repairMaxFlow and of restoring the flow, and n is the number of cities.
      *
-     * @param function A pointer to a flow calculation function.
+     * @param explore_paths Pointer to the member function used to find augmenting paths (bfs_flow or dfs_flow).
+     * @param beforeFlows The flows of the cities before shutting down the stations.
      * @param stations A vector containing the codes of the stations to be shut down.
      * @return A vector of pairs containing the city code and the percentage decrease in flow rate.
      */
-    vector<pair<string,double>> shutdownStationsGettingDecreaseFlows(vector<pair<string,int>> (Manager::*function)(),vector<string>& stations);
+    vector<pair<string,double>> shutdownStationsGettingDecreaseFlows(vector<Edge*> (Manager::*explore_paths)(Vertex*,Vertex*),const vector<pair<string,int>>& beforeFlows,vector<string>& stations);
 
     /* Exercise 3.3 */
 
     /**
      * @brief Disable each pipe individually and check if it affects the network flow using Edmonds-Karp algorithm.
      *
-     * This function iterates through each pipe in the graph, disables it, and checks if the network flow is affected using the Edmonds-Karp algorithm. It records the result for each pipe and saves it to a CSV file.
+     * This function solves the network once with the Edmonds-Karp algorithm and then, for each pipe in the graph, disables it and repairs the flow from the solved network to check if the network flow is affected. It records the result for each pipe and saves it to a CSV file.
      *
      * Time complexity: O(m^2)
      */
@@ -631,12 +1348,21 @@ public:
     /**
      * @brief Disable each pipe individually and check if it affects the network flow using Ford-Fulkerson algorithm.
      *
-     * This function iterates through each pipe in the graph, disables it, and checks if the network flow is affected using the Ford-Fulkerson algorithm. It records the result for each pipe and saves it to a CSV file.
+     * This function solves the network once with the Ford-Fulkerson algorithm and then, for each pipe in the graph, disables it and repairs the flow from the solved network to check if the network flow is affected. It records the result for each pipe and saves it to a CSV file.
      *
      * Time complexity: O(m^2)
      */
     void disableEachPipeFordFulkerson();
 
+    /**
+     * @brief Disable each pipe individually and check if it affects the network flow using the Boykov-Kolmogorov engine.
+     *
+     * This function solves the network once and then, for each pipe, disables it, repairs the flow from the previous scenario and records whether the network was affected. It saves the results to a CSV file.
+     *
+     * Time complexity: O(f(m) + m * r), where r is the time of an incremental repair.
+     */
+    void disableEachPipeBoykovKolmogorov();
+
     /**
      * @brief Disable selected pipes and calculate the decrease rate in flow using Edmonds-Karp algorithm.
      *
@@ -702,7 +1428,186 @@ public:
      */
     void flowRatePerCityFordFulkerson();
 
-    vector<int> getMetrics();
+    /**
+     * @brief Gets the paths the water takes from the reservoirs to the cities using the Edmonds-Karp algorithm.
+     *
+     * The maximum flow is split into weighted reservoir to city paths with decomposeFlow and the graph is reset.
+     *
+     * Time complexity: O(VE^2 + V * E)
+     *
+     * @return The decomposition of the maximum flow.
+     */
+    FlowDecomposition getFlowPathsEdmondsKarp();
+
+    /**
+     * @brief Find the paths the water takes from the reservoirs to the cities using the Edmonds-Karp algorithm.
+     *
+     * This function prints every path with its flow and saves them to a CSV file.
+     *
+     * Time complexity: O(VE^2 + V * E)
+     */
+    void flowPathsEdmondsKarp();
+
+    /**
+     * @brief Find the paths the water takes from the reservoirs to the cities using the Ford-Fulkerson algorithm.
+     *
+     * This function prints every path with its flow and saves them to a CSV file.
+     *
+     * Time complexity: O(E.f + V * E)
+     */
+    void flowPathsFordFulkerson();
+
+    /**
+     * @brief Writes the paths of a flow decomposition in CSV format.
+     *
+     * Each line has the reservoir, the city, the flow and the codes of the vertexes of the path separated by " -> ".
+     *
+     * Time complexity: O(L), where L is the total length of the paths.
+     *
+     * @param out The stream to write to.
+     * @param decomposition The decomposition of the flow.
+     */
+    static void writeFlowPaths(ostream& out, const FlowDecomposition& decomposition);
+
+    /**
+     * @brief Gets how much of the flow of each city comes from each reservoir using the Edmonds-Karp algorithm.
+     *
+     * The maximum flow is attributed with attributeFlow and the graph is reset.
+     *
+     * Time complexity: O(VE^2 + R * (V + E))
+     *
+     * @return The reservoir x city matrix of the maximum flow.
+     */
+    AttributionMatrix getAttributionEdmondsKarp();
+
+    /**
+     * @brief Find which reservoirs supply each city, and how much, using the Edmonds-Karp algorithm.
+     *
+     * This function prints the flow each city receives from each reservoir and saves it to a CSV file.
+     *
+     * Time complexity: O(VE^2 + R * (V + E))
+     */
+    void attributionEdmondsKarp();
+
+    /**
+     * @brief Find which reservoirs supply each city, and how much, using the Ford-Fulkerson algorithm.
+     *
+     * This function prints the flow each city receives from each reservoir and saves it to a CSV file.
+     *
+     * Time complexity: O(E.f + R * (V + E))
+     */
+    void attributionFordFulkerson();
+
+    /**
+     * @brief Writes the non-zero values of an attribution matrix in CSV format.
+     *
+     * Each line has the reservoir, the city, the flow and the percentage of the flow of the city it represents.
+     *
+     * Time complexity: O(R * C), where R is the number of reservoirs and C the number of cities.
+     *
+     * @param out The stream to write to.
+     * @param matrix The attribution matrix.
+     * @param city Index of the only city to write, or -1 to write every city.
+     */
+    static void writeAttribution(ostream& out, const AttributionMatrix& matrix, int city = -1);
+
+    /**
+     * @brief Computes the statistics of the flow of the pipes of the solved graph.
+     *
+     * The flow and capacity of every pipe are gathered from the pipe table into flat arrays and reduced with computeFlowMetrics.
+     *
+     * Time complexity: O(P), where P is the number of pipes.
+     *
+     * @return The statistics of the flow and of the difference between capacity and flow of the pipes.
+     */
+    FlowMetrics getMetrics() const;
+
+    /**
+     * @brief Prints the statistics of the flow of the pipes.
+     *
+     * Time complexity: O(1)
+     *
+     * @param title Title printed before the statistics.
+     * @param metrics The statistics.
+     */
+    static void printMetrics(const string& title, const FlowMetrics& metrics);
+
+    /**
+     * @brief Finds the largest factor every demand can be multiplied by while every city still gets enough water.
+     *
+     * The factor is found with Dinkelbach's method on the cuts of the network, starting from the cut around the
+     * super source: the maximum flow is computed with every demand multiplied by the current factor and, while it
+     * doesn't meet every demand, the factor becomes the capacity of the minimum cut without its edges to the super
+     * sink over the demand of the cities behind it. The factor decreases with every iteration and the first one whose
+     * demands are met is the answer, with the cut that produced it as the binding cut. The factor p / q is kept as an
+     * exact fraction by multiplying the capacities of the pipes by q and the demands by p. The graph is reset.
+     *
+     * Time complexity: O(k * P), where k is the number of iterations, usually a few, and P the time complexity of
+     * the push-relabel engine.
+     *
+     * @return The factor and the binding cut.
+     */
+    DemandGrowth getDemandGrowth();
+
+    /**
+     * @brief Writes the factor of a demand growth, the pipes of its binding cut and the cities behind it in CSV format.
+     *
+     * Time complexity: O(P + C), where P is the number of pipes of the cut and C the number of cities behind it.
+     *
+     * @param out The stream to write to.
+     * @param growth The demand growth.
+     */
+    static void writeDemandGrowth(ostream& out, const DemandGrowth& growth);
+
+    /**
+     * @brief Ranks the pipes by how much water upgrading each one alone adds to the cities.
+     *
+     * Only the pipes in every minimum cut of the baseline flow can add water, so only they are evaluated, each on its
+     * own copy of the solved network with augmenting paths from the baseline flow. A pipe in both directions is
+     * upgraded in both. The graph is reset.
+     *
+     * Time complexity: O(K * (V + E) * P / T), where K is the number of candidate pipes, P the number of augmenting
+     * paths of each one and T the number of hardware threads.
+     *
+     * @param delta The capacity to add to each pipe, or 0 to double the capacity of each pipe.
+     * @return The upgrades, by decreasing gain.
+     */
+    vector<PipeUpgrade> planPipeUpgrades(long long delta);
+
+    /**
+     * @brief Writes pipe upgrades in CSV format, with the cities that get more water separated by spaces.
+     *
+     * Time complexity: O(U * C), where U is the number of upgrades and C the number of cities.
+     *
+     * @param out The stream to write to.
+     * @param upgrades The upgrades, by decreasing gain.
+     */
+    static void writePipeUpgrades(ostream& out, const vector<PipeUpgrade>& upgrades);
+
+    /**
+     * @brief Writes the solver counters as a JSON object on one line.
+     *
+     * Time complexity: O(1)
+     *
+     * @param out The stream to write to.
+     * @param engine Name of the engine that was counted.
+     * @param flow Total flow the engine found.
+     * @param counters The counters.
+     */
+    static void writeSolverCounters(ostream& out, const string& engine, long long flow, const SolverCounters& counters);
+
+    /**
+     * @brief Runs every max-flow engine and failure sweep once and writes the time and hardware counters of each run.
+     *
+     * The rows, in CSV format, have the elapsed milliseconds followed by the cycles, instructions, cache misses and
+     * branch misses of the run, empty when PerfProbe can't count them. The engines are run from a reset graph, the
+     * sweeps write their result files as usual and their console output is discarded.
+     *
+     * Time complexity: The sum of the time of the engines and of the sweeps.
+     *
+     * @param out The stream to write to.
+     */
+    void profileSolvers(ostream& out);
 };
 
 
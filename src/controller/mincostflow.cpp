@@ -0,0 +1,119 @@
+/**
+* @file mincostflow.cpp
+* @brief This file contains the min-cost max-flow engine implementation.
+ */
+
+// Project headers
+#include "mincostflow.h"
+// Standard Library Headers
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <queue>
+
+MinCostFlow::MinCostFlow(const int segments) {
+    this->segments = max(1, segments);
+}
+
+void MinCostFlow::addArc(const int from, const int to, const long long capacity, const long long arcCost, const int origin) {
+    out[from].push_back(static_cast<int>(head.size()));
+    head.push_back(to);
+    residual.push_back(capacity);
+    arcCosts.push_back(arcCost);
+    origins.push_back(origin);
+
+    out[to].push_back(static_cast<int>(head.size()));
+    head.push_back(from);
+    residual.push_back(0);
+    arcCosts.push_back(-arcCost);
+    origins.push_back(-1);
+}
+
+long long MinCostFlow::solve(FlowNetwork& network) {
+    const int n = network.getNumberOfVertexes();
+    source = network.getSource();
+    sink = network.getSink();
+    cost = 0;
+    out.assign(n, vector<int>());
+    head.clear();
+    residual.clear();
+    arcCosts.clear();
+    origins.clear();
+    potential.assign(n, 0);
+
+    // Split the capacity of every pipe in segments of increasing cost
+    for (int a = 0; a < network.getNumberOfArcs(); a++) {
+        const long long capacity = network.getCapacity(a);
+        if (capacity <= 0) continue;
+        const int from = network.getTail(a);
+        const int to = network.getHead(a);
+        if (from == source || to == sink) {
+            addArc(from, to, capacity, 0, a);
+            continue;
+        }
+        for (int k = 0; k < segments; k++) {
+            const long long size = capacity / segments + (k < capacity % segments ? 1 : 0);
+            if (size > 0) {
+                addArc(from, to, size, 2 * k + 1, a);
+            }
+        }
+    }
+
+    while (findPath()) {
+        long long amount = LLONG_MAX;
+        for (int v = sink; v != source; v = head[parent[v] ^ 1]) {
+            amount = min(amount, residual[parent[v]]);
+        }
+        for (int v = sink; v != source; v = head[parent[v] ^ 1]) {
+            residual[parent[v]] -= amount;
+            residual[parent[v] ^ 1] += amount;
+            cost += amount * arcCosts[parent[v]];
+        }
+    }
+
+    // Add up the flow of the segments of each arc and send it through the network
+    vector<long long> flows(network.getNumberOfArcs(), 0);
+    for (size_t a = 0; a < head.size(); a += 2) {
+        flows[origins[a]] += residual[a + 1];
+    }
+    for (int a = 0; a < network.getNumberOfArcs(); a++) {
+        if (flows[a] > 0) {
+            network.push(a, flows[a]);
+        }
+    }
+    return network.getFlowValue();
+}
+
+bool MinCostFlow::findPath() {
+    const int n = static_cast<int>(out.size());
+    distance.assign(n, LLONG_MAX);
+    parent.assign(n, -1);
+
+    priority_queue<pair<long long,int>, vector<pair<long long,int>>, greater<>> q;
+    distance[source] = 0;
+    q.push(make_pair(0, source));
+    while (!q.empty()) {
+        const auto [d, v] = q.top();
+        q.pop();
+        if (d > distance[v]) continue;
+        for (const int a : out[v]) {
+            if (residual[a] <= 0) continue;
+            const int w = head[a];
+            // Reduced costs are never negative, so Dijkstra finds the cheapest path
+            const long long reduced = d + arcCosts[a] + potential[v] - potential[w];
+            if (reduced < distance[w]) {
+                distance[w] = reduced;
+                parent[w] = a;
+                q.push(make_pair(reduced, w));
+            }
+        }
+    }
+    if (distance[sink] == LLONG_MAX) return false;
+
+    for (int v = 0; v < n; v++) {
+        if (distance[v] != LLONG_MAX) {
+            potential[v] += distance[v];
+        }
+    }
+    return true;
+}
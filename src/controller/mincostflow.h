@@ -0,0 +1,91 @@
+#ifndef PROJECTDA_MINCOSTFLOW_H
+#define PROJECTDA_MINCOSTFLOW_H
+/**
+* @file mincostflow.h
+* @brief This file contains the min-cost max-flow engine header.
+ */
+
+// Project headers
+#include "../model/FlowNetwork.h"
+// Standard library headers
+#include <vector>
+using namespace std;
+
+/**
+ * @class MinCostFlow
+ * @brief Min-cost max-flow engine that spreads the flow over the pipes, penalizing highly used pipes.
+ *
+ * The cost of a pipe is a convex piecewise-linear function of its utilization: its capacity is split into segments
+ * of equal size and the k-th segment costs 2k+1 per unit of flow, which approximates a cost proportional to
+ * flow^2 / capacity. Pipes used at the same fraction of their capacity have the same marginal cost, so a flow of
+ * minimum cost has no cheaper way to move water from a busy pipe to a less used one. The edges of the super source
+ * and super sink have no cost.
+ *
+ * The flow is found with successive shortest paths: the cheapest augmenting path is found with Dijkstra over
+ * reduced costs (with vertex potentials) until the sink can't be reached, so the result is a maximum flow of
+ * minimum cost.
+ */
+class MinCostFlow {
+public:
+    /**
+     * @brief Creates the engine.
+     *
+     * Time complexity: O(1)
+     *
+     * @param segments Number of segments of the cost of each pipe.
+     */
+    explicit MinCostFlow(int segments = 8);
+
+    /**
+     * @brief Computes a maximum flow of minimum cost for a network without flow.
+     *
+     * The residual capacities of the network are updated with the result.
+     *
+     * Time complexity: O(P * (S * E) * log(V)), where P is the number of augmenting paths and S the number of segments.
+     *
+     * @param network The network, built from a graph without flow.
+     * @return The value of the flow.
+     */
+    long long solve(FlowNetwork& network);
+
+    /**
+     * @brief Gets the cost of the last flow computed.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The cost.
+     */
+    long long getCost() const { return cost; }
+
+private:
+    /**
+     * @brief Adds an arc and its reverse to the residual graph.
+     * @param from Index of the origin.
+     * @param to Index of the destination.
+     * @param capacity Capacity of the arc.
+     * @param arcCost Cost per unit of flow.
+     * @param origin Index of the network arc the arc is a segment of.
+     */
+    void addArc(int from, int to, long long capacity, long long arcCost, int origin);
+
+    /**
+     * @brief Finds the cheapest augmenting path from the source with Dijkstra and updates the potentials.
+     * @return True if the sink was reached, false otherwise.
+     */
+    bool findPath();
+
+    int segments; /**< Number of segments of the cost of each pipe. */
+    int source = -1; /**< Index of the super source. */
+    int sink = -1; /**< Index of the super sink. */
+    long long cost = 0; /**< Cost of the flow. */
+    vector<vector<int>> out; /**< Arcs leaving each vertex. */
+    vector<int> head; /**< Destination of each arc. */
+    vector<long long> residual; /**< Residual capacity of each arc. */
+    vector<long long> arcCosts; /**< Cost of each arc, the reverse of a segment has the opposite cost. */
+    vector<int> origins; /**< Network arc of each segment, -1 for the reverse arcs. */
+    vector<long long> potential; /**< Potential of each vertex, the reduced costs are never negative. */
+    vector<long long> distance; /**< Reduced distance of each vertex from the source in the last search. */
+    vector<int> parent; /**< Arc each vertex was reached by in the last search. */
+};
+
+#endif //PROJECTDA_MINCOSTFLOW_H
@@ -0,0 +1,132 @@
+/**
+* @file networkreduction.cpp
+* @brief This file contains the series-parallel network reduction implementation.
+ */
+
+// Project headers
+#include "networkreduction.h"
+// Standard library headers
+#include <algorithm>
+
+NetworkReduction::NetworkReduction(const FlowNetwork& network) {
+    const int n = network.getNumberOfVertexes();
+    const int source = network.getSource();
+    const int sink = network.getSink();
+    for (int a = 0; a < network.getNumberOfArcs(); a++) {
+        if (a > network.getReverse(a)) continue;
+        pipes.push_back({network.getTail(a), network.getHead(a), network.getCapacity(a), network.getCapacity(network.getReverse(a))});
+        pipeArc.push_back(a);
+    }
+    originalPipes = pipes.size();
+
+    incident.resize(n);
+    vector<int> pending;
+    for (size_t p = 0; p < originalPipes; p++) {
+        addPipe(static_cast<int>(p), pending);
+    }
+    for (int v = 0; v < n; v++) {
+        pending.push_back(v);
+    }
+    while (!pending.empty()) {
+        const int v = pending.back();
+        pending.pop_back();
+        if (v == source || v == sink) continue;
+        if (incident[v].size() == 1) {
+            // A dead end can't carry flow
+            const int p = incident[v].begin()->second;
+            removePipe(p);
+            steps.push_back({Step::DROP, p, -1, -1, 0, 0});
+            pending.push_back(pipes[p].tail == v ? pipes[p].head : pipes[p].tail);
+        }
+        else if (incident[v].size() == 2) {
+            // Every unit of flow that enters the vertex through one pipe leaves through the other
+            auto it = incident[v].begin();
+            const int first = it->second;
+            const int second = (++it)->second;
+            const int x = pipes[first].tail == v ? pipes[first].head : pipes[first].tail;
+            const int y = pipes[second].tail == v ? pipes[second].head : pipes[second].tail;
+            removePipe(first);
+            removePipe(second);
+            const int p = static_cast<int>(pipes.size());
+            pipes.push_back({x, y, min(getCapacityFrom(first, x), getCapacityFrom(second, v)), min(getCapacityFrom(second, y), getCapacityFrom(first, v))});
+            steps.push_back({Step::CONTRACT, p, first, second, 0, 0});
+            addPipe(p, pending);
+            pending.push_back(x);
+            pending.push_back(y);
+        }
+    }
+
+    vector<FlowNetwork::Pipe> remaining;
+    vector<int> remainingPipe;
+    for (int v = 0; v < n; v++) {
+        for (const auto& [w, p] : incident[v]) {
+            if (pipes[p].tail != v) continue;
+            remaining.push_back({pipes[p].tail, pipes[p].head, pipes[p].capacity, pipes[p].reverseCapacity});
+            remainingPipe.push_back(p);
+        }
+    }
+    vector<int> arcs;
+    reduced.build(n, source, sink, remaining, arcs);
+    reducedArc.assign(pipes.size(), -1);
+    for (size_t i = 0; i < remaining.size(); i++) {
+        reducedArc[remainingPipe[i]] = arcs[i];
+    }
+    reducedPipes = static_cast<int>(remaining.size());
+}
+
+long long NetworkReduction::getCapacityFrom(const int p, const int from) const {
+    return pipes[p].tail == from ? pipes[p].capacity : pipes[p].reverseCapacity;
+}
+
+void NetworkReduction::addPipe(const int p, vector<int>& pending) {
+    Pipe& pipe = pipes[p];
+    if (pipe.tail == pipe.head || (pipe.capacity == 0 && pipe.reverseCapacity == 0)) {
+        steps.push_back({Step::DROP, p, -1, -1, 0, 0});
+        pending.push_back(pipe.tail);
+        pending.push_back(pipe.head);
+        return;
+    }
+    const auto it = incident[pipe.tail].find(pipe.head);
+    if (it == incident[pipe.tail].end()) {
+        incident[pipe.tail][pipe.head] = p;
+        incident[pipe.head][pipe.tail] = p;
+        return;
+    }
+    Pipe& into = pipes[it->second];
+    steps.push_back({Step::MERGE, it->second, p, -1, into.capacity, into.reverseCapacity});
+    into.capacity += getCapacityFrom(p, into.tail);
+    into.reverseCapacity += getCapacityFrom(p, into.head);
+}
+
+void NetworkReduction::removePipe(const int p) {
+    incident[pipes[p].tail].erase(pipes[p].head);
+    incident[pipes[p].head].erase(pipes[p].tail);
+}
+
+void NetworkReduction::expand(FlowNetwork& network) const {
+    // Net flow of each pipe from its tail to its head
+    vector<long long> flow(pipes.size(), 0);
+    for (size_t p = 0; p < pipes.size(); p++) {
+        if (reducedArc[p] >= 0) flow[p] = reduced.getFlow(reducedArc[p]);
+    }
+    for (auto step = steps.rbegin(); step != steps.rend(); ++step) {
+        const long long f = flow[step->pipe];
+        if (step->kind == Step::DROP) {
+            flow[step->pipe] = 0;
+        }
+        else if (step->kind == Step::MERGE) {
+            // The pipe merged into keeps as much of the flow as it had room for
+            const long long kept = f >= 0 ? min(f, step->capacity) : max(f, -step->reverseCapacity);
+            flow[step->pipe] = kept;
+            flow[step->first] = pipes[step->first].tail == pipes[step->pipe].tail ? f - kept : kept - f;
+        }
+        else {
+            const Pipe& result = pipes[step->pipe];
+            flow[step->first] = pipes[step->first].tail == result.tail ? f : -f;
+            flow[step->second] = pipes[step->second].head == result.head ? f : -f;
+        }
+    }
+    for (size_t p = 0; p < originalPipes; p++) {
+        network.push(pipeArc[p], flow[p] - network.getFlow(pipeArc[p]));
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef PROJECTDA_NETWORKREDUCTION_H
+#define PROJECTDA_NETWORKREDUCTION_H
+/**
+* @file networkreduction.h
+* @brief This file contains the series-parallel network reduction header.
+ */
+
+// Project headers
+#include "../model/FlowNetwork.h"
+// Standard library headers
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+/**
+ * @class NetworkReduction
+ * @brief A smaller network with the same maximum flow, whose flow expands back to the original network.
+ *
+ * The pipes of the network, each a pair of opposite arcs, are reduced until no rule applies:
+ * - a pipe without capacity in either direction, or from a vertex to itself, is dropped;
+ * - a pipe to a vertex without other pipes, other than the source and the sink, is dropped, as it can't carry flow;
+ * - two pipes between the same vertexes are merged into one with the sum of their capacities in each direction;
+ * - the two pipes of a vertex with exactly two pipes, other than the source and the sink, like the stations of a
+ *   pumping chain, are contracted into one with the smallest of their capacities in each direction.
+ *
+ * Every reduction is pushed on a stack. The flow of the reduced network is expanded by undoing the reductions in
+ * reverse order: a contracted pipe gives its flow to both of its pipes, a merged pipe fills the first of its pipes
+ * before the second, and a dropped pipe gets no flow.
+ *
+ * The reduction uses the current capacities of the network, so disabled vertexes and pipes are dropped.
+ */
+class NetworkReduction {
+public:
+    /**
+     * @brief Reduces a network.
+     *
+     * Time complexity: O(V + E) expected.
+     *
+     * @param network The network.
+     */
+    explicit NetworkReduction(const FlowNetwork& network);
+
+    /**
+     * @brief Gets the reduced network, for a solver to compute its maximum flow.
+     * @return Reference to the reduced network.
+     */
+    FlowNetwork& getReduced() { return reduced; }
+
+    /**
+     * @brief Writes the flow of the reduced network to the arcs of the original network.
+     *
+     * Time complexity: O(V + E)
+     *
+     * @param network The original network, with the capacities it had when it was reduced.
+     */
+    void expand(FlowNetwork& network) const;
+
+    int getNumberOfPipes() const { return static_cast<int>(originalPipes); } /**< @brief Gets the number of pipes of the original network. */
+    int getNumberOfReducedPipes() const { return reducedPipes; } /**< @brief Gets the number of pipes of the reduced network. */
+
+private:
+    /**
+     * @struct Pipe
+     * @brief A pipe of the original network or made by a reduction.
+     */
+    struct Pipe {
+        int tail; /**< Origin of the arc. */
+        int head; /**< Destination of the arc. */
+        long long capacity; /**< Capacity from the tail to the head. */
+        long long reverseCapacity; /**< Capacity from the head to the tail. */
+    };
+
+    /**
+     * @struct Step
+     * @brief A reduction, kept to be undone.
+     */
+    struct Step {
+        enum Kind { DROP, MERGE, CONTRACT } kind; /**< The rule applied. */
+        int pipe; /**< The dropped pipe, the pipe merged into, or the pipe made by the contraction. */
+        int first; /**< The merged pipe, or the pipe of the contraction from the tail of the result. */
+        int second; /**< The pipe of the contraction to the head of the result. */
+        long long capacity; /**< Capacity of the pipe merged into, before the merge. */
+        long long reverseCapacity; /**< Reverse capacity of the pipe merged into, before the merge. */
+    };
+
+    /**
+     * @brief Gets the capacity of a pipe leaving one of its vertexes.
+     * @param p The pipe.
+     * @param from The vertex.
+     * @return The capacity of the direction that leaves the vertex.
+     */
+    long long getCapacityFrom(int p, int from) const;
+
+    /**
+     * @brief Adds a pipe, merging it into the pipe between the same vertexes or dropping it without capacity.
+     * @param p The pipe.
+     * @param pending Vertexes whose pipes changed, to check again.
+     */
+    void addPipe(int p, vector<int>& pending);
+
+    /**
+     * @brief Removes a pipe from the pipes of its vertexes.
+     * @param p The pipe.
+     */
+    void removePipe(int p);
+
+    vector<Pipe> pipes; /**< The pipes, first the ones of the original network. */
+    size_t originalPipes = 0; /**< Number of pipes of the original network. */
+    vector<int> pipeArc; /**< Arc of each original pipe in the original network, from its tail to its head. */
+    vector<unordered_map<int,int>> incident; /**< Pipe of each vertex to each of its neighbours. */
+    vector<Step> steps; /**< The reductions, in the order they were applied. */
+    vector<int> reducedArc; /**< Arc of each pipe in the reduced network, -1 if it was reduced. */
+    int reducedPipes = 0; /**< Number of pipes of the reduced network. */
+    FlowNetwork reduced; /**< The reduced network. */
+};
+
+#endif //PROJECTDA_NETWORKREDUCTION_H
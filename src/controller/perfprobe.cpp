@@ -0,0 +1,97 @@
+/**
+* @file perfprobe.cpp
+* @brief This file contains the hardware performance counter probe implementation.
+ */
+
+// Project headers
+#include "perfprobe.h"
+// Standard library headers
+#ifdef __linux__
+#include <cstdint>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+
+PerfProbe::PerfProbe() {
+    const uint64_t configs[COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    for (int i = 0; i < COUNTERS; i++) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+    }
+}
+
+PerfProbe::~PerfProbe() {
+    for (const int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+void PerfProbe::start() {
+    for (const int fd : fds) {
+        if (fd < 0) continue;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+PerfProbe::Sample PerfProbe::stop() {
+    long long values[COUNTERS];
+    for (int i = 0; i < COUNTERS; i++) {
+        values[i] = -1;
+        if (fds[i] < 0) continue;
+        ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        // The value, the time the counter was enabled and the time it was running
+        uint64_t data[3];
+        if (read(fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0) continue;
+        values[i] = static_cast<long long>(data[2] < data[1] ? static_cast<double>(data[0]) * data[1] / data[2] : data[0]);
+    }
+    Sample sample;
+    sample.cycles = values[0];
+    sample.instructions = values[1];
+    sample.cacheMisses = values[2];
+    sample.branchMisses = values[3];
+    return sample;
+}
+
+#else
+
+PerfProbe::PerfProbe() = default;
+
+PerfProbe::~PerfProbe() = default;
+
+void PerfProbe::start() {}
+
+PerfProbe::Sample PerfProbe::stop() {
+    return {};
+}
+
+#endif
+
+bool PerfProbe::isAvailable() const {
+    for (const int fd : fds) {
+        if (fd >= 0) return true;
+    }
+    return false;
+}
+
+void PerfProbe::writeFields(ostream& out, const Sample& sample) {
+    for (const long long value : {sample.cycles, sample.instructions, sample.cacheMisses, sample.branchMisses}) {
+        out << ",";
+        if (value >= 0) out << value;
+    }
+}
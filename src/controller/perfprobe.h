@@ -0,0 +1,87 @@
+#ifndef PROJECTDA_PERFPROBE_H
+#define PROJECTDA_PERFPROBE_H
+/**
+* @file perfprobe.h
+* @brief This file contains the hardware performance counter probe header.
+ */
+
+// Standard library headers
+#include <ostream>
+using namespace std;
+
+/**
+ * @class PerfProbe
+ * @brief Counts the cycles, instructions, cache misses and branch misses of the process between start and stop.
+ *
+ * On Linux the counters are opened with perf_event_open for the user space of the calling thread and of the
+ * threads it creates while counting, like the workers of the solvers. A counter the kernel or the hardware doesn't
+ * provide, for example in a virtual machine or with a restrictive perf_event_paranoid, is left out and reported as
+ * not counted; on other systems nothing is counted. When the kernel multiplexes the counters, their values are
+ * scaled to the time they were enabled.
+ */
+class PerfProbe {
+public:
+    /**
+     * @struct Sample
+     * @brief The counts of one measurement, -1 for the counters that are not available.
+     */
+    struct Sample {
+        long long cycles = -1; /**< CPU cycles. */
+        long long instructions = -1; /**< Instructions retired. */
+        long long cacheMisses = -1; /**< Last level cache misses. */
+        long long branchMisses = -1; /**< Mispredicted branches. */
+    };
+
+    /**
+     * @brief Opens the counters, disabled.
+     *
+     * Time complexity: O(1)
+     */
+    PerfProbe();
+
+    /**
+     * @brief Closes the counters.
+     */
+    ~PerfProbe();
+
+    PerfProbe(const PerfProbe&) = delete;
+    PerfProbe& operator=(const PerfProbe&) = delete;
+
+    /**
+     * @brief Checks if any counter could be opened.
+     * @return True if at least one counter is available.
+     */
+    bool isAvailable() const;
+
+    /**
+     * @brief Resets the counters and starts counting.
+     *
+     * Time complexity: O(1)
+     */
+    void start();
+
+    /**
+     * @brief Stops counting and reads the counters.
+     *
+     * Time complexity: O(1)
+     *
+     * @return The counts since start.
+     */
+    Sample stop();
+
+    /**
+     * @brief Writes the counts of a sample as CSV fields, each preceded by a comma, empty for the ones not counted.
+     *
+     * Time complexity: O(1)
+     *
+     * @param out The stream to write to.
+     * @param sample The sample.
+     */
+    static void writeFields(ostream& out, const Sample& sample);
+
+private:
+    static constexpr int COUNTERS = 4; /**< Number of counters. */
+    int fds[COUNTERS] = {-1, -1, -1, -1}; /**< File descriptor of each counter, -1 if it couldn't be opened. */
+};
+
+#endif //PROJECTDA_PERFPROBE_H
@@ -0,0 +1,209 @@
+/**
+* @file pushrelabel.cpp
+* @brief This file contains the parallel push-relabel max-flow engine implementation.
+ */
+
+// Project headers
+#include "pushrelabel.h"
+#include "tracer.h"
+// Standard Library Headers
+#include <algorithm>
+#include <climits>
+#include <thread>
+
+PushRelabel::PushRelabel(const unsigned threads) {
+    this->threads = threads > 0 ? threads : max(1u, thread::hardware_concurrency());
+}
+
+long long PushRelabel::solve(FlowNetwork& network) {
+    this->network = &network;
+    n = network.getNumberOfVertexes();
+    const int m = network.getNumberOfArcs();
+    const int source = network.getSource();
+
+    residual = vector<atomic<long long>>(m);
+    for (int a = 0; a < m; a++) {
+        residual[a] = network.getResidual(a);
+    }
+    excess = vector<atomic<long long>>(n);
+    height = vector<atomic<int>>(n);
+    queued = vector<atomic<bool>>(n);
+    queues.clear();
+    for (unsigned i = 0; i < threads; i++) {
+        queues.push_back(make_unique<WorkQueue>());
+    }
+    relabelLimit = max(1, n / 2);
+
+    // Saturate every arc leaving the source
+    for (int a = network.getFirstArc(source); a < network.getEndArc(source); a++) {
+        const long long d = residual[a];
+        if (d <= 0) continue;
+        residual[a] -= d;
+        residual[network.getReverse(a)] += d;
+        excess[network.getHead(a)] += d;
+    }
+
+    while (true) {
+        globalRelabel();
+        relabels = 0;
+        stop = false;
+        pending = 0;
+        unsigned next = 0;
+        for (int v = 0; v < n; v++) {
+            queued[v] = false;
+            if (v == source || v == network.getSink() || excess[v] <= 0 || height[v] >= n) continue;
+            queued[v] = true;
+            pending++;
+            queues[next]->vertexes.push_back(v);
+            next = (next + 1) % threads;
+        }
+        if (pending == 0) break;
+        runPhase();
+        for (const auto& q : queues) {
+            q->vertexes.clear();
+        }
+    }
+
+    // Copy the residual capacities back, one push per pair of arcs keeps both in sync
+    for (int a = 0; a < m; a++) {
+        if (network.getReverse(a) < a) continue;
+        network.push(a, network.getResidual(a) - residual[a]);
+    }
+
+    // The preflow is maximum, the excess left in vertexes that can't reach the sink goes back to the source
+    for (int v = 0; v < n; v++) {
+        if (v != source && v != network.getSink() && excess[v] > 0) {
+            network.returnExcess(v, excess[v]);
+        }
+    }
+    return network.getFlowValue();
+}
+
+void PushRelabel::globalRelabel() {
+    const int source = network->getSource();
+    const int sink = network->getSink();
+    for (int v = 0; v < n; v++) {
+        height[v] = n;
+    }
+
+    // Breadth-first search from the sink over arcs with residual capacity towards it
+    vector<int> q;
+    q.reserve(n);
+    height[sink] = 0;
+    q.push_back(sink);
+    for (size_t i = 0; i < q.size(); i++) {
+        const int x = q[i];
+        for (int a = network->getFirstArc(x); a < network->getEndArc(x); a++) {
+            const int w = network->getHead(a);
+            if (height[w] != n || w == source || residual[network->getReverse(a)] <= 0) continue;
+            height[w] = height[x] + 1;
+            q.push_back(w);
+        }
+    }
+}
+
+void PushRelabel::runPhase() {
+    vector<thread> workers;
+    for (unsigned id = 1; id < threads; id++) {
+        workers.emplace_back(&PushRelabel::work, this, id);
+    }
+    work(0);
+    for (auto& t : workers) {
+        t.join();
+    }
+}
+
+void PushRelabel::work(const unsigned id) {
+    Tracer::Scope scope("push-relabel phase");
+    int u;
+    while (!stop) {
+        if (!take(id, u)) {
+            if (pending == 0) return;
+            this_thread::yield();
+            continue;
+        }
+        if (!discharge(u, id)) {
+            // The phase stopped, u stays queued for the next one
+            lock_guard<mutex> guard(queues[id]->lock);
+            queues[id]->vertexes.push_back(u);
+            continue;
+        }
+        // Someone may have pushed to u after its excess was checked, so check it again after leaving the queue
+        queued[u] = false;
+        if (excess[u] > 0 && height[u] < n && !queued[u].exchange(true)) {
+            lock_guard<mutex> guard(queues[id]->lock);
+            queues[id]->vertexes.push_back(u);
+        }
+        else {
+            pending--;
+        }
+    }
+}
+
+bool PushRelabel::discharge(const int u, const unsigned id) {
+    const int source = network->getSource();
+    const int sink = network->getSink();
+    // A vertex at height n can't reach the sink, its excess is returned to the source after the last phase
+    while (excess[u] > 0 && height[u] < n) {
+        if (stop) return false;
+
+        // Find the lowest neighbour over arcs with residual capacity
+        int best = -1;
+        int lowest = INT_MAX;
+        for (int a = network->getFirstArc(u); a < network->getEndArc(u); a++) {
+            if (residual[a].load(memory_order_relaxed) <= 0) continue;
+            const int h = height[network->getHead(a)].load(memory_order_relaxed);
+            if (h < lowest) {
+                lowest = h;
+                best = a;
+            }
+        }
+        if (best < 0) break;
+
+        if (height[u] > lowest) {
+            // Only the owner of u decreases its excess and the residual capacity of its arcs, so d stays valid
+            const long long d = min(excess[u].load(), residual[best].load());
+            const int v = network->getHead(best);
+            residual[best] -= d;
+            residual[network->getReverse(best)] += d;
+            excess[u] -= d;
+            excess[v] += d;
+            if (v != source && v != sink && height[v] < n) {
+                enqueue(v, id);
+            }
+        }
+        else {
+            height[u] = lowest + 1;
+            if (++relabels > relabelLimit) {
+                stop = true;
+            }
+        }
+    }
+    return true;
+}
+
+void PushRelabel::enqueue(const int v, const unsigned id) {
+    if (queued[v].exchange(true)) return;
+    pending++;
+    lock_guard<mutex> guard(queues[id]->lock);
+    queues[id]->vertexes.push_back(v);
+}
+
+bool PushRelabel::take(const unsigned id, int& v) {
+    for (unsigned k = 0; k < threads; k++) {
+        WorkQueue& q = *queues[(id + k) % threads];
+        lock_guard<mutex> guard(q.lock);
+        if (q.vertexes.empty()) continue;
+        // The own queue is used as a stack, stealing takes the oldest vertex
+        if (k == 0) {
+            v = q.vertexes.back();
+            q.vertexes.pop_back();
+        }
+        else {
+            v = q.vertexes.front();
+            q.vertexes.pop_front();
+        }
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,116 @@
+#ifndef PROJECTDA_PUSHRELABEL_H
+#define PROJECTDA_PUSHRELABEL_H
+/**
+* @file pushrelabel.h
+* @brief This file contains the parallel push-relabel max-flow engine header.
+ */
+
+// Project headers
+#include "../model/FlowNetwork.h"
+// Standard library headers
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+using namespace std;
+
+/**
+ * @class PushRelabel
+ * @brief Multithreaded push-relabel max-flow engine with lock-free excess and height updates.
+ *
+ * Each active vertex (a vertex with excess) is owned by one thread at a time, which pushes its excess to the lowest
+ * neighbour or relabels it, following the asynchronous algorithm of Hong and He: residual capacities and excesses
+ * are only changed with atomic additions, so no locks are taken on vertexes or arcs. Active vertexes are kept in one
+ * queue per thread and idle threads steal from the other queues. The threads run in phases: once enough relabels
+ * were done they stop, the heights are recomputed exactly from the sink (global relabel) and a new phase starts.
+ * Vertexes that can't reach the sink are left out, so the phases compute a maximum preflow and the excess left in
+ * those vertexes is then returned to the source along the flow paths.
+ */
+class PushRelabel {
+public:
+    /**
+     * @brief Creates the engine.
+     *
+     * Time complexity: O(1)
+     *
+     * @param threads Number of worker threads, 0 to use the number of hardware threads.
+     */
+    explicit PushRelabel(unsigned threads = 0);
+
+    /**
+     * @brief Computes the maximum flow of the network, starting from the flow it already has.
+     *
+     * The residual capacities of the network are updated with the result.
+     *
+     * Time complexity: O(V^2 * E) in the worst case, close to linear in practice for sparse networks.
+     *
+     * @param network The network, already built.
+     * @return The value of the maximum flow.
+     */
+    long long solve(FlowNetwork& network);
+
+private:
+    /**
+     * @struct WorkQueue
+     * @brief Queue of active vertexes of one thread.
+     */
+    struct WorkQueue {
+        mutex lock; /**< Protects the vertexes. */
+        deque<int> vertexes; /**< Active vertexes, the owner takes from the back and thieves from the front. */
+    };
+
+    /**
+     * @brief Recomputes every height as the residual distance to the sink, or n if the sink can't be reached.
+     */
+    void globalRelabel();
+
+    /**
+     * @brief Runs one phase with every thread, until there are no active vertexes or a global relabel is due.
+     */
+    void runPhase();
+
+    /**
+     * @brief Takes active vertexes from the own queue or from other queues and discharges them.
+     * @param id Index of the thread.
+     */
+    void work(unsigned id);
+
+    /**
+     * @brief Pushes and relabels a vertex until it has no excess, it can't reach the sink or the phase stops.
+     * @param u Index of the vertex.
+     * @param id Index of the thread, whose queue gets the vertexes that become active.
+     * @return True if the vertex is no longer active, false if the phase stopped first.
+     */
+    bool discharge(int u, unsigned id);
+
+    /**
+     * @brief Adds a vertex to a queue if it is not in one.
+     * @param v Index of the vertex.
+     * @param id Index of the queue.
+     */
+    void enqueue(int v, unsigned id);
+
+    /**
+     * @brief Takes a vertex from the own queue or steals one from another queue.
+     * @param id Index of the thread.
+     * @param v Set to the vertex taken.
+     * @return True if a vertex was taken, false if every queue is empty.
+     */
+    bool take(unsigned id, int& v);
+
+    unsigned threads; /**< Number of worker threads. */
+    FlowNetwork* network = nullptr; /**< The network being solved. */
+    int n = 0; /**< Number of vertexes. */
+    vector<atomic<long long>> residual; /**< Residual capacity of each arc while solving. */
+    vector<atomic<long long>> excess; /**< Excess of each vertex. */
+    vector<atomic<int>> height; /**< Height of each vertex. */
+    vector<atomic<bool>> queued; /**< Whether each vertex is in a queue or being discharged. */
+    vector<unique_ptr<WorkQueue>> queues; /**< Queue of each thread. */
+    atomic<long long> pending{0}; /**< Vertexes queued or being discharged. */
+    atomic<long long> relabels{0}; /**< Relabels done since the last global relabel. */
+    atomic<bool> stop{false}; /**< Whether the current phase must stop. */
+    long long relabelLimit = 0; /**< Relabels after which a global relabel is done. */
+};
+
+#endif //PROJECTDA_PUSHRELABEL_H
@@ -0,0 +1,126 @@
+/**
+* @file regionsolver.cpp
+* @brief This file contains the parallel region max-flow solver implementation.
+ */
+
+// Project headers
+#include "regionsolver.h"
+#include "pushrelabel.h"
+#include "tracer.h"
+// Standard library headers
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <thread>
+
+RegionSolver::RegionSolver(const unsigned threads) {
+    this->threads = threads > 0 ? threads : max(1u, thread::hardware_concurrency());
+}
+
+long long RegionSolver::solve(FlowNetwork& network) {
+    // An arc from the source straight to the sink, like a reduced chain, belongs to no region
+    for (int a = network.getFirstArc(network.getSource()); a < network.getEndArc(network.getSource()); a++) {
+        if (network.getHead(a) == network.getSink() && network.getResidual(a) > 0) {
+            network.push(a, network.getResidual(a));
+        }
+    }
+
+    const vector<Region> found = findRegions(network);
+    regions = static_cast<int>(found.size());
+    if (found.empty()) return network.getFlowValue();
+    if (found.size() == 1) return PushRelabel(threads).solve(network);
+
+    vector<size_t> order(found.size());
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return found[a].pipes.size() > found[b].pipes.size(); });
+
+    // Every region is solved on its own copy, the network is only written once all of them are done
+    vector<vector<long long>> flows(found.size());
+    atomic<size_t> next(0);
+    auto work = [&] {
+        for (size_t i = next++; i < order.size(); i = next++) {
+            solveRegion(found[order[i]], flows[order[i]]);
+        }
+    };
+    vector<thread> workers;
+    const size_t count = min<size_t>(threads, found.size());
+    for (size_t t = 1; t < count; t++) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (size_t r = 0; r < found.size(); r++) {
+        for (size_t p = 0; p < found[r].arcs.size(); p++) {
+            network.push(found[r].arcs[p], flows[r][p]);
+        }
+    }
+    return network.getFlowValue();
+}
+
+vector<RegionSolver::Region> RegionSolver::findRegions(const FlowNetwork& network) {
+    const int n = network.getNumberOfVertexes();
+    const int source = network.getSource();
+    const int sink = network.getSink();
+    vector<int> region(n, -1);
+    vector<int> local(n, -1);
+    vector<Region> all;
+    vector<int> queue;
+    for (int s = 0; s < n; s++) {
+        if (s == source || s == sink || region[s] >= 0) continue;
+        const int r = static_cast<int>(all.size());
+        all.emplace_back();
+        queue.assign(1, s);
+        region[s] = r;
+        local[s] = all[r].vertexes++;
+        for (size_t i = 0; i < queue.size(); i++) {
+            const int u = queue[i];
+            for (int a = network.getFirstArc(u); a < network.getEndArc(u); a++) {
+                const int w = network.getHead(a);
+                if (w == source || w == sink || region[w] >= 0) continue;
+                region[w] = r;
+                local[w] = all[r].vertexes++;
+                queue.push_back(w);
+            }
+        }
+    }
+
+    // Each pair of arcs is copied from the vertex of the region, or from the lowest arc of the pair
+    for (int u = 0; u < n; u++) {
+        if (u == source || u == sink) continue;
+        Region& current = all[region[u]];
+        for (int a = network.getFirstArc(u); a < network.getEndArc(u); a++) {
+            const int w = network.getHead(a);
+            const int r = network.getReverse(a);
+            const bool terminal = w == source || w == sink;
+            if (!terminal && a > r) continue;
+            const long long capacity = network.getResidual(a);
+            const long long reverseCapacity = network.getResidual(r);
+            if (capacity <= 0 && reverseCapacity <= 0) continue;
+            if (w == source && reverseCapacity > 0) current.fromSource = true;
+            if (w == sink && capacity > 0) current.toSink = true;
+            current.pipes.push_back({local[u], w == source ? 0 : w == sink ? 1 : local[w], capacity, reverseCapacity});
+            current.arcs.push_back(a);
+        }
+    }
+
+    vector<Region> flowing;
+    for (Region& current : all) {
+        if (current.fromSource && current.toSink) flowing.push_back(std::move(current));
+    }
+    return flowing;
+}
+
+void RegionSolver::solveRegion(const Region& region, vector<long long>& flows) {
+    Tracer::Scope scope("solve region");
+    FlowNetwork network;
+    vector<int> pipeArcs;
+    network.build(region.vertexes, 0, 1, region.pipes, pipeArcs);
+    PushRelabel(1).solve(network);
+    flows.resize(pipeArcs.size());
+    for (size_t p = 0; p < pipeArcs.size(); p++) {
+        flows[p] = network.getFlow(pipeArcs[p]);
+    }
+}
@@ -0,0 +1,89 @@
+#ifndef PROJECTDA_REGIONSOLVER_H
+#define PROJECTDA_REGIONSOLVER_H
+/**
+* @file regionsolver.h
+* @brief This file contains the parallel region max-flow solver header.
+ */
+
+// Project headers
+#include "../model/FlowNetwork.h"
+// Standard library headers
+#include <vector>
+using namespace std;
+
+/**
+ * @class RegionSolver
+ * @brief Max-flow solver that splits a network into independent supply regions and solves them in parallel.
+ *
+ * Without the super source and the super sink, a network may fall apart in weakly connected regions, like the
+ * islands of an archipelago, that share no pipe. The maximum flow of the network is the sum of the maximum flows of
+ * its regions, so each region is copied to a network of its own, with its own source and sink, and solved by a
+ * single-threaded push-relabel engine, the regions being spread over the threads, largest first. The flow of every
+ * region is then added to the arcs of the network. A network with a single region is solved by the multithreaded
+ * push-relabel engine instead. Regions without arcs from the source or to the sink are skipped, as they carry no
+ * flow, and arcs from the source straight to the sink are saturated first.
+ */
+class RegionSolver {
+public:
+    /**
+     * @brief Creates the solver.
+     *
+     * Time complexity: O(1)
+     *
+     * @param threads Number of worker threads, 0 to use the number of hardware threads.
+     */
+    explicit RegionSolver(unsigned threads = 0);
+
+    /**
+     * @brief Computes the maximum flow of the network, starting from the flow it already has.
+     *
+     * The residual capacities of the network are updated with the result.
+     *
+     * Time complexity: O(V + E) plus the push-relabel time of the largest region, when there are enough threads.
+     *
+     * @param network The network, already built.
+     * @return The value of the maximum flow.
+     */
+    long long solve(FlowNetwork& network);
+
+    /**
+     * @brief Gets the number of regions that could carry flow in the last network solved.
+     * @return The number of regions.
+     */
+    int getNumberOfRegions() const { return regions; }
+
+private:
+    /**
+     * @struct Region
+     * @brief A weakly connected region of the network, without the source and the sink.
+     */
+    struct Region {
+        int vertexes = 2; /**< Number of vertexes, counting its own source (0) and sink (1). */
+        vector<FlowNetwork::Pipe> pipes; /**< Its pipes, in its own vertex indexes. */
+        vector<int> arcs; /**< Arc of each pipe in the network, from its tail to its head. */
+        bool fromSource = false; /**< Whether an arc from the source reaches it. */
+        bool toSink = false; /**< Whether an arc to the sink leaves it. */
+    };
+
+    /**
+     * @brief Finds the regions of a network and copies their pipes, with the residual capacities of the network.
+     *
+     * Time complexity: O(V + E)
+     *
+     * @param network The network.
+     * @return The regions that can carry flow.
+     */
+    static vector<Region> findRegions(const FlowNetwork& network);
+
+    /**
+     * @brief Computes the maximum flow of a region.
+     * @param region The region.
+     * @param flows Set to the flow of each pipe of the region, from its tail to its head.
+     */
+    static void solveRegion(const Region& region, vector<long long>& flows);
+
+    unsigned threads; /**< Number of worker threads. */
+    int regions = 0; /**< Number of regions of the last network solved. */
+};
+
+#endif //PROJECTDA_REGIONSOLVER_H
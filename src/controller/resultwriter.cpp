@@ -0,0 +1,102 @@
+/**
+* @file resultwriter.cpp
+* @brief This file contains the result writer implementation.
+ */
+
+// Project headers
+#include "resultwriter.h"
+#include "tracer.h"
+// Standard library headers
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+ResultWriter::ResultWriter(string directory, string prefix, string extension, const unsigned threads)
+    : directory(std::move(directory)), prefix(std::move(prefix)), extension(std::move(extension)) {
+    this->threads = threads > 0 ? threads : max(1u, min(4u, thread::hardware_concurrency()));
+}
+
+ResultWriter::~ResultWriter() {
+    flush();
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    queued.notify_all();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+string ResultWriter::getPath(const string& name) const {
+    return getPath(name, extension);
+}
+
+string ResultWriter::getPath(const string& name, const string& extension) const {
+    if (directory.empty()) return prefix + name + extension;
+    return directory + "/" + prefix + name + extension;
+}
+
+void ResultWriter::write(const string& path, string contents) {
+    {
+        lock_guard<mutex> guard(lock);
+        checkFailures();
+        queue.emplace_back(path, std::move(contents));
+        if (queue.size() > idle && workers.size() < threads) workers.emplace_back(&ResultWriter::run, this);
+    }
+    queued.notify_one();
+}
+
+void ResultWriter::flush() {
+    unique_lock<mutex> guard(lock);
+    written.wait(guard, [this] { return queue.empty() && writing.empty(); });
+    checkFailures();
+}
+
+void ResultWriter::run() {
+    unique_lock<mutex> guard(lock);
+    while (true) {
+        size_t next;
+        idle++;
+        queued.wait(guard, [&] { return (next = findWritable()) < queue.size() || (stopping && queue.empty()); });
+        idle--;
+        if (next == queue.size()) return;
+        pair<string, string> file = std::move(queue[next]);
+        queue.erase(queue.begin() + static_cast<ptrdiff_t>(next));
+        writing.insert(file.first);
+        guard.unlock();
+
+        Tracer::Scope scope("write file", file.first);
+        const string temporary = file.first + ".tmp";
+        ofstream outputCSV(temporary, ios::binary);
+        bool ok = outputCSV.is_open() &&
+                  outputCSV.write(file.second.data(), static_cast<streamsize>(file.second.size())).flush();
+        outputCSV.close();
+        ok = ok && std::rename(temporary.c_str(), file.first.c_str()) == 0;
+        if (!ok) std::remove(temporary.c_str());
+
+        guard.lock();
+        writing.erase(file.first);
+        if (!ok) failures.push_back(file.first);
+        // A file queued for the same path may be waiting for this one
+        queued.notify_all();
+        if (queue.empty() && writing.empty()) written.notify_all();
+    }
+}
+
+size_t ResultWriter::findWritable() const {
+    for (size_t i = 0; i < queue.size(); i++) {
+        if (writing.count(queue[i].first) == 0) return i;
+    }
+    return queue.size();
+}
+
+void ResultWriter::checkFailures() {
+    if (failures.empty()) return;
+    for (const string& path : failures) {
+        cerr << "Error: Unable to open file " << path << "." << endl;
+    }
+    exit(EXIT_FAILURE);
+}
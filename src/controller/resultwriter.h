@@ -0,0 +1,145 @@
+#ifndef PROJECTDA_RESULTWRITER_H
+#define PROJECTDA_RESULTWRITER_H
+/**
+* @file resultwriter.h
+* @brief This file contains the result writer header.
+ */
+
+// Standard library headers
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+using namespace std;
+
+/**
+ * @class ResultWriter
+ * @brief Writes the result files on background I/O threads.
+ *
+ * Every result file is built in memory by the caller and handed over whole, so the file is written in one block with
+ * a single flush. The files are queued and written by a few I/O threads, started as the files are queued, so the
+ * caller doesn't wait for the disk and independent files are written concurrently. Files queued for the same path are
+ * written one at a time in the order they were queued, so the last one queued is the one left on disk.
+ * Each file is written next to its path, with a ".tmp" suffix, and renamed over the previous file once complete, so a
+ * program reading the results never sees a half written file.
+ *
+ * The path of a result named "name" is "<directory>/<prefix>name<extension>".
+ */
+class ResultWriter {
+public:
+    /**
+     * @brief Creates a writer.
+     *
+     * Time complexity: O(1)
+     *
+     * @param directory Directory of the result files.
+     * @param prefix Prefix of the name of every file.
+     * @param extension Extension of every file.
+     * @param threads Maximum number of I/O threads, 0 to use up to four, one per hardware thread.
+     */
+    explicit ResultWriter(string directory = "../data/results", string prefix = "results_", string extension = ".csv",
+                          unsigned threads = 0);
+
+    /**
+     * @brief Waits for the queued files to be written and stops the I/O threads.
+     *
+     * Time complexity: O(B), where B is the size of the files still queued.
+     */
+    ~ResultWriter();
+
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    /**
+     * @brief Gets the path of a result file.
+     *
+     * Time complexity: O(L), where L is the length of the path.
+     *
+     * @param name The name of the result, without prefix or extension.
+     * @return The path of the file.
+     */
+    string getPath(const string& name) const;
+
+    /**
+     * @brief Gets the path of a result file with another extension.
+     *
+     * Time complexity: O(L), where L is the length of the path.
+     *
+     * @param name The name of the result, without prefix or extension.
+     * @param extension The extension of the file.
+     * @return The path of the file.
+     */
+    string getPath(const string& name, const string& extension) const;
+
+    /**
+     * @brief Queues a file to be written, replacing the file if it exists.
+     *
+     * Time complexity: O(1), the file is written by an I/O thread.
+     *
+     * @param path The path of the file.
+     * @param contents The contents of the file.
+     */
+    void write(const string& path, string contents);
+
+    /**
+     * @brief Waits until every queued file is written.
+     *
+     * Prints an error and terminates the program if a file couldn't be written.
+     *
+     * Time complexity: O(B), where B is the size of the files still queued.
+     */
+    void flush();
+
+    void setDirectory(const string& directory) { this->directory = directory; } /**< @brief Sets the directory of the result files. */
+    void setPrefix(const string& prefix) { this->prefix = prefix; } /**< @brief Sets the prefix of the name of every file. */
+    void setExtension(const string& extension) { this->extension = extension; } /**< @brief Sets the extension of every file. */
+    const string& getDirectory() const { return directory; } /**< @brief Gets the directory of the result files. */
+    const string& getPrefix() const { return prefix; } /**< @brief Gets the prefix of the name of every file. */
+    const string& getExtension() const { return extension; } /**< @brief Gets the extension of every file. */
+
+private:
+    /**
+     * @brief Writes the queued files until the writer is destroyed.
+     */
+    void run();
+
+    /**
+     * @brief Finds the first queued file whose path isn't being written by another thread.
+     *
+     * The lock must be held.
+     *
+     * Time complexity: O(Q log W), where Q is the number of queued files and W the number of files being written.
+     *
+     * @return The position of the file in the queue, or the size of the queue if there is none.
+     */
+    size_t findWritable() const;
+
+    /**
+     * @brief Prints the files that couldn't be written and terminates the program, if there are any.
+     *
+     * The lock must be held.
+     */
+    void checkFailures();
+
+    string directory; /**< Directory of the result files. */
+    string prefix; /**< Prefix of the name of every file. */
+    string extension; /**< Extension of every file. */
+
+    unsigned threads; /**< Maximum number of I/O threads. */
+
+    mutex lock; /**< Protects the queue, the failures and the state of the threads. */
+    condition_variable queued; /**< Signaled when a file is queued or written, or the writer stops. */
+    condition_variable written; /**< Signaled when the queue becomes empty and no file is being written. */
+    deque<pair<string, string>> queue; /**< Path and contents of the files to write. */
+    set<string> writing; /**< Paths of the files being written. */
+    vector<string> failures; /**< Paths of the files that couldn't be written. */
+    unsigned idle = 0; /**< Number of threads waiting for a file. */
+    bool stopping = false; /**< Whether the writer is being destroyed. */
+    vector<thread> workers; /**< The I/O threads, started as files are queued. */
+};
+
+#endif //PROJECTDA_RESULTWRITER_H
@@ -0,0 +1,258 @@
+/**
+* @file sweepresults.cpp
+* @brief This file contains the implementation of the columnar binary format of the results of failure sweeps.
+ */
+
+// Project headers
+#include "sweepresults.h"
+// Standard library headers
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+// System headers
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char FILE_MAGIC[8] = {'W', 'S', 'S', 'W', 'E', 'E', 'P', '\0'};
+static const char BLOCK_MAGIC[4] = {'B', 'L', 'K', '1'};
+static const char METRICS_MAGIC[4] = {'M', 'E', 'T', '1'};
+static const uint32_t VERSION = 2;
+
+// The metrics are written and mapped as they are in memory
+static_assert(is_trivially_copyable<FlowMetrics>::value && sizeof(FlowMetrics) % 8 == 0, "FlowMetrics must be a plain record");
+
+/**
+ * @brief Header at the start of a sweep file.
+ */
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+};
+
+/**
+ * @brief Header at the start of each block.
+ */
+struct BlockHeader {
+    char magic[4];
+    uint32_t rows;
+    uint32_t newCodes;
+    uint32_t codesBytes;
+};
+
+/**
+ * @brief Rounds a size up to a multiple of 8 bytes.
+ * @param n The size.
+ * @return The padded size.
+ */
+static size_t pad(const size_t n) {
+    return (n + 7) & ~static_cast<size_t>(7);
+}
+
+/**
+ * @brief Prints an error about a sweep file and terminates the program.
+ * @param path The path of the file.
+ * @param reason What is wrong with it.
+ */
+[[noreturn]] static void fail(const string& path, const string& reason) {
+    cerr << "Error: " << reason << ": " << path << endl;
+    exit(EXIT_FAILURE);
+}
+
+/* ------------------- SweepWriter ----------------------------- */
+
+SweepWriter::SweepWriter(const string& path, const bool append, const size_t blockRows)
+    : blockRows(blockRows == 0 ? 1 : blockRows) {
+    struct stat info{};
+    const bool resume = append && stat(path.c_str(), &info) == 0 && info.st_size > 0;
+    if (resume) {
+        // Continue the dictionary of the file, so the ids of the new blocks follow the old ones
+        const SweepReader reader(path);
+        for (uint32_t id = 0; id < reader.getCodes().size(); id++) {
+            ids.emplace(reader.getCode(id), id);
+        }
+    }
+
+    file.open(path, ios::binary | (resume ? ios::app : ios::trunc));
+    if (!file.is_open()) fail(path, "Unable to open file");
+    if (!resume) {
+        FileHeader header{};
+        memcpy(header.magic, FILE_MAGIC, sizeof(header.magic));
+        header.version = VERSION;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+}
+
+SweepWriter::~SweepWriter() {
+    flush();
+}
+
+uint32_t SweepWriter::intern(const string& code) {
+    const auto [it, added] = ids.emplace(code, static_cast<uint32_t>(ids.size()));
+    if (added) newCodes.push_back(code);
+    return it->second;
+}
+
+void SweepWriter::addScenario(const string& scenario, const vector<pair<string,int>>& flows, const FlowDiff& diff, const FlowMetrics& metrics) {
+    const uint32_t id = intern(scenario);
+    metricScenarios.push_back(id);
+    this->metrics.push_back(metrics);
+    for (size_t i = 0; i < flows.size(); i++) {
+        scenarios.push_back(id);
+        cities.push_back(intern(flows[i].first));
+        before.push_back(diff.before[i]);
+        after.push_back(diff.after[i]);
+        decline.push_back(static_cast<float>(diff.decline[i]));
+        if (scenarios.size() >= blockRows) flush();
+    }
+}
+
+void SweepWriter::flush() {
+    if (scenarios.empty() && newCodes.empty() && metrics.empty()) return;
+
+    string block;
+    size_t codesBytes = 0;
+    for (const string& code : newCodes) codesBytes += sizeof(uint32_t) + code.size();
+    const size_t rows = scenarios.size();
+    block.reserve(sizeof(BlockHeader) + pad(codesBytes) + pad(rows * 5 * sizeof(uint32_t)));
+
+    BlockHeader header{};
+    memcpy(header.magic, BLOCK_MAGIC, sizeof(header.magic));
+    header.rows = static_cast<uint32_t>(rows);
+    header.newCodes = static_cast<uint32_t>(newCodes.size());
+    header.codesBytes = static_cast<uint32_t>(codesBytes);
+    block.append(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const string& code : newCodes) {
+        const auto length = static_cast<uint32_t>(code.size());
+        block.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        block.append(code);
+    }
+    block.resize(sizeof(BlockHeader) + pad(codesBytes), '\0');
+
+    block.append(reinterpret_cast<const char*>(scenarios.data()), rows * sizeof(uint32_t));
+    block.append(reinterpret_cast<const char*>(cities.data()), rows * sizeof(uint32_t));
+    block.append(reinterpret_cast<const char*>(before.data()), rows * sizeof(int32_t));
+    block.append(reinterpret_cast<const char*>(after.data()), rows * sizeof(int32_t));
+    block.append(reinterpret_cast<const char*>(decline.data()), rows * sizeof(float));
+    block.resize(pad(block.size()), '\0');
+
+    // The metrics follow the block with the codes of their scenarios
+    if (!metrics.empty()) {
+        BlockHeader metricsHeader{};
+        memcpy(metricsHeader.magic, METRICS_MAGIC, sizeof(metricsHeader.magic));
+        metricsHeader.rows = static_cast<uint32_t>(metrics.size());
+        block.append(reinterpret_cast<const char*>(&metricsHeader), sizeof(metricsHeader));
+        block.append(reinterpret_cast<const char*>(metricScenarios.data()), metrics.size() * sizeof(uint32_t));
+        block.resize(pad(block.size()), '\0');
+        block.append(reinterpret_cast<const char*>(metrics.data()), metrics.size() * sizeof(FlowMetrics));
+    }
+
+    file.write(block.data(), static_cast<streamsize>(block.size()));
+    file.flush();
+
+    metricScenarios.clear();
+    metrics.clear();
+    newCodes.clear();
+    scenarios.clear();
+    cities.clear();
+    before.clear();
+    after.clear();
+    decline.clear();
+}
+
+/* ------------------- SweepReader ----------------------------- */
+
+SweepReader::SweepReader(const string& path) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) fail(path, "Unable to open file");
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(FileHeader)) {
+        close(fd);
+        fail(path, "Not a sweep file");
+    }
+    size = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) fail(path, "Unable to map file");
+    data = static_cast<const unsigned char*>(mapping);
+
+    FileHeader header{};
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, FILE_MAGIC, sizeof(header.magic)) != 0 || header.version < 1 || header.version > VERSION) {
+        fail(path, "Not a sweep file");
+    }
+
+    size_t offset = sizeof(FileHeader);
+    while (offset < size) {
+        BlockHeader block{};
+        if (size - offset < sizeof(block)) fail(path, "Truncated sweep file");
+        memcpy(&block, data + offset, sizeof(block));
+        offset += sizeof(block);
+        if (memcmp(block.magic, METRICS_MAGIC, sizeof(block.magic)) == 0) {
+            const size_t rows = block.rows;
+            const size_t scenarioBytes = pad(rows * sizeof(uint32_t));
+            if (rows > (size - offset) / sizeof(FlowMetrics) || scenarioBytes + rows * sizeof(FlowMetrics) > size - offset) {
+                fail(path, "Truncated sweep file");
+            }
+            MetricsBlock view{};
+            view.rows = rows;
+            view.scenario = reinterpret_cast<const uint32_t*>(data + offset);
+            view.metrics = reinterpret_cast<const FlowMetrics*>(data + offset + scenarioBytes);
+            metricsBlocks.push_back(view);
+            offset += scenarioBytes + rows * sizeof(FlowMetrics);
+            continue;
+        }
+        if (memcmp(block.magic, BLOCK_MAGIC, sizeof(block.magic)) != 0) fail(path, "Corrupted sweep file");
+
+        const size_t codesEnd = offset + block.codesBytes;
+        if (pad(block.codesBytes) > size - offset) fail(path, "Truncated sweep file");
+        for (uint32_t i = 0; i < block.newCodes; i++) {
+            uint32_t length = 0;
+            if (codesEnd - offset < sizeof(length)) fail(path, "Corrupted sweep file");
+            memcpy(&length, data + offset, sizeof(length));
+            offset += sizeof(length);
+            if (codesEnd - offset < length) fail(path, "Corrupted sweep file");
+            codes.emplace_back(reinterpret_cast<const char*>(data + offset), length);
+            offset += length;
+        }
+        offset = codesEnd + (pad(block.codesBytes) - block.codesBytes);
+
+        const size_t rows = block.rows;
+        if (pad(rows * 5 * sizeof(uint32_t)) > size - offset) fail(path, "Truncated sweep file");
+        const auto* columns = reinterpret_cast<const uint32_t*>(data + offset);
+        Block view{};
+        view.rows = rows;
+        view.scenario = columns;
+        view.city = columns + rows;
+        view.before = reinterpret_cast<const int32_t*>(columns + 2 * rows);
+        view.after = reinterpret_cast<const int32_t*>(columns + 3 * rows);
+        view.decline = reinterpret_cast<const float*>(columns + 4 * rows);
+        blocks.push_back(view);
+        offset += pad(rows * 5 * sizeof(uint32_t));
+    }
+
+    for (const Block& view : blocks) {
+        for (size_t i = 0; i < view.rows; i++) {
+            if (view.scenario[i] >= codes.size() || view.city[i] >= codes.size()) fail(path, "Corrupted sweep file");
+        }
+    }
+    for (const MetricsBlock& view : metricsBlocks) {
+        for (size_t i = 0; i < view.rows; i++) {
+            if (view.scenario[i] >= codes.size()) fail(path, "Corrupted sweep file");
+        }
+    }
+}
+
+SweepReader::~SweepReader() {
+    if (data != nullptr) munmap(const_cast<unsigned char*>(data), size);
+}
+
+size_t SweepReader::getNumberOfRows() const {
+    size_t rows = 0;
+    for (const Block& block : blocks) rows += block.rows;
+    return rows;
+}
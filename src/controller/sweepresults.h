@@ -0,0 +1,180 @@
+#ifndef PROJECTDA_SWEEPRESULTS_H
+#define PROJECTDA_SWEEPRESULTS_H
+/**
+* @file sweepresults.h
+* @brief This file contains the header of the columnar binary format of the results of failure sweeps.
+ */
+
+// Project headers
+#include "../model/FlowDiff.h"
+#include "../model/FlowMetrics.h"
+// Standard library headers
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+using namespace std;
+
+/*
+ * Layout of a sweep file, in native byte order:
+ *
+ *   file header   "WSSWEEP" '\0', uint32 version, uint32 reserved
+ *   block*        "BLK1", uint32 rows, uint32 new codes, uint32 bytes of the new codes,
+ *                 the new codes (uint32 length + characters each), padded to 8 bytes,
+ *                 uint32 scenario[rows], uint32 city[rows], int32 before[rows], int32 after[rows], float decline[rows],
+ *                 padded to 8 bytes
+ *               | "MET1", uint32 rows, uint32 0, uint32 0,
+ *                 uint32 scenario[rows], padded to 8 bytes, FlowMetrics metrics[rows]
+ *
+ * Scenarios and cities are ids in one dictionary of codes, which every block extends with the codes it uses for the
+ * first time, so blocks can be appended to an existing file. A metrics block has the statistics of the flow of the
+ * pipes after each scenario and always follows the block that added the codes of its scenarios. Metrics blocks were
+ * added in version 2, files of both versions can be read.
+ */
+
+/**
+ * @class SweepWriter
+ * @brief Writes the per-city comparison of the scenarios of a failure sweep to a columnar binary file.
+ *
+ * Rows are buffered in columns and written as one block when the buffer is full or the writer is closed.
+ */
+class SweepWriter {
+public:
+    /**
+     * @brief Opens a sweep file.
+     *
+     * Prints an error and terminates the program if the file can't be opened or is not a sweep file.
+     *
+     * Time complexity: O(1), or O(D) when appending to a file with D bytes of codes.
+     *
+     * @param path The path of the file.
+     * @param append Whether to keep the scenarios already in the file.
+     * @param blockRows Number of rows of each block.
+     */
+    explicit SweepWriter(const string& path, bool append = false, size_t blockRows = 1 << 16);
+
+    /**
+     * @brief Writes the buffered rows and closes the file.
+     *
+     * Time complexity: O(B), where B is the number of buffered rows.
+     */
+    ~SweepWriter();
+
+    SweepWriter(const SweepWriter&) = delete;
+    SweepWriter& operator=(const SweepWriter&) = delete;
+
+    /**
+     * @brief Adds one row per city with the comparison of a scenario, and the statistics of the flow of its pipes.
+     *
+     * Time complexity: O(C), where C is the number of cities.
+     *
+     * @param scenario The code of the scenario, as the elements disabled.
+     * @param flows The flow of each city before the scenario, giving the code of each city.
+     * @param diff The comparison of the flows before and after the scenario.
+     * @param metrics The statistics of the flow of the pipes after the scenario.
+     */
+    void addScenario(const string& scenario, const vector<pair<string,int>>& flows, const FlowDiff& diff, const FlowMetrics& metrics);
+
+    /**
+     * @brief Writes the buffered rows as a block, followed by the buffered metrics.
+     *
+     * Time complexity: O(B), where B is the number of buffered rows and metrics.
+     */
+    void flush();
+
+private:
+    /**
+     * @brief Gets the id of a code, adding it to the dictionary if it is new.
+     * @param code The code.
+     * @return The id.
+     */
+    uint32_t intern(const string& code);
+
+    ofstream file; /**< The sweep file. */
+    size_t blockRows; /**< Number of rows of each block. */
+    unordered_map<string, uint32_t> ids; /**< Id of each code in the dictionary. */
+    vector<string> newCodes; /**< Codes added to the dictionary since the last block. */
+    vector<uint32_t> scenarios; /**< Scenario of each buffered row. */
+    vector<uint32_t> cities; /**< City of each buffered row. */
+    vector<int32_t> before; /**< Flow of the city before the scenario, for each buffered row. */
+    vector<int32_t> after; /**< Flow of the city after the scenario, for each buffered row. */
+    vector<float> decline; /**< Percentage of its flow the city lost, for each buffered row. */
+    vector<uint32_t> metricScenarios; /**< Scenario of each buffered metrics. */
+    vector<FlowMetrics> metrics; /**< Statistics of the flow of the pipes after each buffered scenario. */
+};
+
+/**
+ * @class SweepReader
+ * @brief Maps a sweep file into memory and gives access to its columns without copying them.
+ */
+class SweepReader {
+public:
+    /**
+     * @brief Columns of one block of a sweep file.
+     */
+    struct Block {
+        size_t rows; /**< Number of rows. */
+        const uint32_t* scenario; /**< Id of the scenario of each row. */
+        const uint32_t* city; /**< Id of the city of each row. */
+        const int32_t* before; /**< Flow of the city before the scenario. */
+        const int32_t* after; /**< Flow of the city after the scenario. */
+        const float* decline; /**< Percentage of its flow the city lost. */
+    };
+
+    /**
+     * @brief Statistics of the flow of the pipes of the scenarios of one metrics block.
+     */
+    struct MetricsBlock {
+        size_t rows; /**< Number of scenarios. */
+        const uint32_t* scenario; /**< Id of each scenario. */
+        const FlowMetrics* metrics; /**< Statistics of the flow of the pipes after each scenario. */
+    };
+
+    /**
+     * @brief Maps a sweep file.
+     *
+     * Prints an error and terminates the program if the file can't be mapped or is not a valid sweep file.
+     *
+     * Time complexity: O(K + D + N), where K is the number of blocks, D the size of the dictionary and N the number of rows,
+     * whose ids are checked against the dictionary.
+     *
+     * @param path The path of the file.
+     */
+    explicit SweepReader(const string& path);
+
+    /**
+     * @brief Unmaps the file.
+     *
+     * Time complexity: O(1)
+     */
+    ~SweepReader();
+
+    SweepReader(const SweepReader&) = delete;
+    SweepReader& operator=(const SweepReader&) = delete;
+
+    /**
+     * @brief Gets the total number of rows.
+     *
+     * Time complexity: O(K), where K is the number of blocks.
+     *
+     * @return The number of rows.
+     */
+    size_t getNumberOfRows() const;
+
+    const vector<Block>& getBlocks() const { return blocks; } /**< @brief Gets the blocks, in file order. */
+    const vector<MetricsBlock>& getMetricsBlocks() const { return metricsBlocks; } /**< @brief Gets the metrics blocks, in file order. */
+    const vector<string>& getCodes() const { return codes; } /**< @brief Gets the dictionary of codes. */
+    const string& getCode(uint32_t id) const { return codes[id]; } /**< @brief Gets the code with an id. */
+
+private:
+    const unsigned char* data = nullptr; /**< Start of the mapping. */
+    size_t size = 0; /**< Size of the mapping. */
+    vector<Block> blocks; /**< Columns of each block. */
+    vector<MetricsBlock> metricsBlocks; /**< Scenarios and statistics of each metrics block. */
+    vector<string> codes; /**< Code with each id. */
+};
+
+#endif //PROJECTDA_SWEEPRESULTS_H
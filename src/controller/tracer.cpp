@@ -0,0 +1,118 @@
+/**
+* @file tracer.cpp
+* @brief This file contains the trace event recorder implementation.
+ */
+
+// Project headers
+#include "tracer.h"
+// Standard library headers
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+atomic<bool> Tracer::enabled(false);
+atomic<unsigned> Tracer::session(0);
+chrono::steady_clock::time_point Tracer::origin;
+string Tracer::path;
+mutex Tracer::registry;
+vector<unique_ptr<Tracer::Buffer>> Tracer::buffers;
+thread_local Tracer::Buffer* Tracer::localBuffer = nullptr;
+thread_local unsigned Tracer::localSession = 0;
+
+Tracer::Scope::Scope(const char* name) : name(name), start(isEnabled() ? now() : -1) {}
+
+Tracer::Scope::Scope(const char* name, const string& detail) : name(name), start(-1) {
+    if (!isEnabled()) return;
+    this->detail = detail;
+    start = now();
+}
+
+Tracer::Scope::~Scope() {
+    if (start < 0 || !isEnabled()) return;
+    const long long end = now();
+    getBuffer().events.push_back({name, std::move(detail), start, end});
+}
+
+void Tracer::start(const string& path) {
+    lock_guard<mutex> guard(registry);
+    buffers.clear();
+    Tracer::path = path;
+    origin = chrono::steady_clock::now();
+    session++;
+    enabled = true;
+    // The thread that starts the trace is always the first one
+    buffers.push_back(make_unique<Buffer>(Buffer{0, {}}));
+    localBuffer = buffers.back().get();
+    localSession = session;
+}
+
+bool Tracer::stop() {
+    if (!enabled.exchange(false)) return false;
+    lock_guard<mutex> guard(registry);
+    ofstream out(path);
+    if (!out.is_open()) {
+        cerr << "Error: Unable to open file " << path << "." << endl;
+        return false;
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    out << fixed << setprecision(3);
+    bool first = true;
+    for (const auto& buffer : buffers) {
+        out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->thread
+            << ",\"args\":{\"name\":\"" << (buffer->thread == 0 ? "main" : "worker " + to_string(buffer->thread)) << "\"}}";
+        first = false;
+        for (const Event& event : buffer->events) {
+            out << ",\n{\"name\":";
+            writeString(out, event.name);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread << ",\"ts\":" << event.start / 1000.0
+                << ",\"dur\":" << (event.end - event.start) / 1000.0;
+            if (!event.detail.empty()) {
+                out << ",\"args\":{\"detail\":";
+                writeString(out, event.detail);
+                out << "}";
+            }
+            out << "}";
+        }
+    }
+    out << "\n]}\n";
+    buffers.clear();
+    if (!out.flush()) {
+        cerr << "Error: Unable to write file " << path << "." << endl;
+        return false;
+    }
+    return true;
+}
+
+bool Tracer::isEnabled() {
+    return enabled.load(memory_order_relaxed);
+}
+
+long long Tracer::now() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - origin).count();
+}
+
+Tracer::Buffer& Tracer::getBuffer() {
+    if (localBuffer == nullptr || localSession != session) {
+        lock_guard<mutex> guard(registry);
+        buffers.push_back(make_unique<Buffer>(Buffer{static_cast<int>(buffers.size()), {}}));
+        localBuffer = buffers.back().get();
+        localSession = session;
+    }
+    return *localBuffer;
+}
+
+void Tracer::writeString(ostream& out, const string& text) {
+    out << '"';
+    for (const char c : text) {
+        if (c == '"' || c == '\\') out << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[7];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out << escaped;
+        }
+        else out << c;
+    }
+    out << '"';
+}
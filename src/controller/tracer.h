@@ -0,0 +1,139 @@
+#ifndef PROJECTDA_TRACER_H
+#define PROJECTDA_TRACER_H
+/**
+* @file tracer.h
+* @brief This file contains the trace event recorder header.
+ */
+
+// Standard library headers
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * @class Tracer
+ * @brief Records timed scopes of every thread and writes them as a Chrome trace, for chrome://tracing or Perfetto.
+ *
+ * Tracing is off until start is called. Each thread appends its events to a buffer of its own, registered with the
+ * tracer on the first event of the thread, so recording takes no lock. While tracing is off a scope only reads one
+ * flag. The buffers are read by stop, which must be called once the traced threads are idle or joined.
+ */
+class Tracer {
+public:
+    /**
+     * @class Scope
+     * @brief Records the time between its construction and its destruction as one complete event.
+     */
+    class Scope {
+    public:
+        /**
+         * @brief Starts the event, if tracing is on.
+         * @param name Name of the event, a string literal.
+         */
+        explicit Scope(const char* name);
+
+        /**
+         * @brief Starts the event with a detail, shown as an argument of the event, if tracing is on.
+         * @param name Name of the event, a string literal.
+         * @param detail The detail, like the code of a vertex or the path of a file.
+         */
+        Scope(const char* name, const string& detail);
+
+        /**
+         * @brief Ends the event and records it in the buffer of the thread.
+         */
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* name; /**< Name of the event. */
+        string detail; /**< Detail of the event, empty for none. */
+        long long start; /**< Start of the event in nanoseconds since tracing started, -1 if tracing was off. */
+    };
+
+    /**
+     * @brief Starts tracing, dropping the events of a previous trace.
+     *
+     * The calling thread is named "main" in the trace.
+     *
+     * Time complexity: O(B), where B is the number of buffers of the previous trace.
+     *
+     * @param path Path of the trace file written by stop.
+     */
+    static void start(const string& path);
+
+    /**
+     * @brief Stops tracing and writes the events of every thread to the trace file.
+     *
+     * Prints an error if the file can't be written.
+     *
+     * Time complexity: O(N), where N is the number of events.
+     *
+     * @return True if tracing was on and the file was written, false otherwise.
+     */
+    static bool stop();
+
+    /**
+     * @brief Checks if tracing is on.
+     * @return True if tracing is on.
+     */
+    static bool isEnabled();
+
+private:
+    /**
+     * @struct Event
+     * @brief A complete event.
+     */
+    struct Event {
+        const char* name; /**< Name of the event. */
+        string detail; /**< Detail of the event, empty for none. */
+        long long start; /**< Start in nanoseconds since tracing started. */
+        long long end; /**< End in nanoseconds since tracing started. */
+    };
+
+    /**
+     * @struct Buffer
+     * @brief The events of one thread.
+     */
+    struct Buffer {
+        int thread; /**< Index of the thread in the trace. */
+        vector<Event> events; /**< The events, in the order they ended. */
+    };
+
+    /**
+     * @brief Gets the time since tracing started.
+     * @return The time in nanoseconds.
+     */
+    static long long now();
+
+    /**
+     * @brief Gets the buffer of the calling thread, registering a new one on the first event of the thread.
+     * @return Reference to the buffer.
+     */
+    static Buffer& getBuffer();
+
+    /**
+     * @brief Writes a string as a JSON string, with its quotes.
+     * @param out The stream to write to.
+     * @param text The string.
+     */
+    static void writeString(ostream& out, const string& text);
+
+    static atomic<bool> enabled; /**< Whether tracing is on. */
+    static atomic<unsigned> session; /**< Number of the current trace, to tell the buffers of a previous one apart. */
+    static chrono::steady_clock::time_point origin; /**< When tracing started. */
+    static string path; /**< Path of the trace file. */
+    static mutex registry; /**< Protects the buffers while a thread registers its own. */
+    static vector<unique_ptr<Buffer>> buffers; /**< Buffer of every thread that recorded an event. */
+    static thread_local Buffer* localBuffer; /**< Buffer of the calling thread. */
+    static thread_local unsigned localSession; /**< Trace the buffer of the calling thread belongs to. */
+};
+
+#endif //PROJECTDA_TRACER_H
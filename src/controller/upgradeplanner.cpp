@@ -0,0 +1,113 @@
+/**
+* @file upgradeplanner.cpp
+* @brief This file contains the pipe upgrade planner implementation.
+ */
+
+// Project headers
+#include "upgradeplanner.h"
+#include "tracer.h"
+// Standard Library Headers
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <thread>
+
+UpgradePlanner::UpgradePlanner(const unsigned threads) {
+    this->threads = threads > 0 ? threads : max(1u, thread::hardware_concurrency());
+}
+
+vector<UpgradePlanner::Upgrade> UpgradePlanner::plan(const FlowNetwork& network, const long long delta) const {
+    const vector<int> candidates = findCandidates(network);
+    vector<Upgrade> upgrades(candidates.size());
+
+    // The network is only read, every evaluation works on its own copy
+    atomic<size_t> next(0);
+    auto work = [&] {
+        for (size_t i = next++; i < candidates.size(); i = next++) {
+            const int arc = candidates[i];
+            upgrades[i] = evaluate(network, arc, delta > 0 ? delta : network.getBaseCapacity(arc));
+        }
+    };
+    vector<thread> workers;
+    const size_t count = min<size_t>(threads, candidates.size());
+    for (size_t t = 1; t < count; t++) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    stable_sort(upgrades.begin(), upgrades.end(), [](const Upgrade& a, const Upgrade& b) { return a.gain > b.gain; });
+    return upgrades;
+}
+
+vector<int> UpgradePlanner::findCandidates(const FlowNetwork& network) {
+    const vector<unsigned char> sourceSide = network.getSourceSide();
+    const vector<unsigned char> sinkSide = network.getSinkSide();
+    vector<int> candidates;
+    for (int v = 0; v < network.getNumberOfVertexes(); v++) {
+        if (!sourceSide[v] || v == network.getSource()) continue;
+        for (int a = network.getFirstArc(v); a < network.getEndArc(v); a++) {
+            const int w = network.getHead(a);
+            if (w != network.getSink() && sinkSide[w] && network.getEdge(a) != nullptr && network.getCapacity(a) > 0) {
+                candidates.push_back(a);
+            }
+        }
+    }
+    return candidates;
+}
+
+UpgradePlanner::Upgrade UpgradePlanner::evaluate(const FlowNetwork& network, const int arc, const long long delta) {
+    Tracer::Scope scope("evaluate upgrade");
+    FlowNetwork upgraded = network;
+    upgraded.setBaseCapacity(arc, network.getBaseCapacity(arc) + delta);
+    const int reverse = network.getReverse(arc);
+    if (network.getEdge(reverse) != nullptr) {
+        upgraded.setBaseCapacity(reverse, network.getBaseCapacity(reverse) + delta);
+    }
+    Upgrade upgrade = {arc, delta, augment(upgraded), {}};
+
+    // Augmenting paths end in an arc to the sink, so the flow of a city never decreases
+    const int sink = network.getSink();
+    for (int a = network.getFirstArc(sink); a < network.getEndArc(sink); a++) {
+        const int toSink = network.getReverse(a);
+        const long long gain = upgraded.getFlow(toSink) - network.getFlow(toSink);
+        if (gain > 0) upgrade.cities.emplace_back(network.getHead(a), gain);
+    }
+    return upgrade;
+}
+
+long long UpgradePlanner::augment(FlowNetwork& network) {
+    const int n = network.getNumberOfVertexes();
+    const int source = network.getSource();
+    const int sink = network.getSink();
+    vector<int> parent(n);
+    vector<int> queue;
+    long long total = 0;
+    while (true) {
+        fill(parent.begin(), parent.end(), -1);
+        queue.assign(1, source);
+        parent[source] = INT_MAX;
+        for (size_t i = 0; i < queue.size() && parent[sink] < 0; i++) {
+            const int v = queue[i];
+            for (int a = network.getFirstArc(v); a < network.getEndArc(v); a++) {
+                const int w = network.getHead(a);
+                if (parent[w] < 0 && network.getResidual(a) > 0) {
+                    parent[w] = a;
+                    queue.push_back(w);
+                }
+            }
+        }
+        if (parent[sink] < 0) return total;
+
+        long long bottleneck = LLONG_MAX;
+        for (int v = sink; v != source; v = network.getTail(parent[v])) {
+            bottleneck = min(bottleneck, network.getResidual(parent[v]));
+        }
+        for (int v = sink; v != source; v = network.getTail(parent[v])) {
+            network.push(parent[v], bottleneck);
+        }
+        total += bottleneck;
+    }
+}
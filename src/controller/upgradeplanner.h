@@ -0,0 +1,91 @@
+#ifndef PROJECTDA_UPGRADEPLANNER_H
+#define PROJECTDA_UPGRADEPLANNER_H
+/**
+* @file upgradeplanner.h
+* @brief This file contains the pipe upgrade planner header.
+ */
+
+// Project headers
+#include "../model/FlowNetwork.h"
+// Standard library headers
+#include <utility>
+#include <vector>
+using namespace std;
+
+/**
+ * @class UpgradePlanner
+ * @brief Ranks pipe capacity upgrades by how much they increase the maximum flow.
+ *
+ * Only a pipe in every minimum cut, from a vertex the source reaches to a vertex that reaches the sink in the
+ * residual network, increases the maximum flow when it is upgraded alone, so those are the only candidates. Each
+ * candidate is evaluated on its own copy of the solved network: the capacity is increased and the flow is augmented
+ * from the maximum flow it already has, which needs at most a few augmenting paths since the gain can't be larger than
+ * the upgrade. The candidates are split between worker threads.
+ */
+class UpgradePlanner {
+public:
+    /**
+     * @struct Upgrade
+     * @brief The result of upgrading one pipe.
+     */
+    struct Upgrade {
+        int arc; /**< The arc of the pipe, in the direction of the cut. */
+        long long delta; /**< The capacity added to the pipe. */
+        long long gain; /**< The increase of the maximum flow. */
+        vector<pair<int, long long>> cities; /**< Vertex of each city that gets more flow, and how much more. */
+    };
+
+    /**
+     * @brief Creates the planner.
+     *
+     * Time complexity: O(1)
+     *
+     * @param threads Number of worker threads, 0 to use the number of hardware threads.
+     */
+    explicit UpgradePlanner(unsigned threads = 0);
+
+    /**
+     * @brief Evaluates the upgrade of every candidate pipe of a solved network.
+     *
+     * A pipe in both directions is upgraded in both.
+     *
+     * Time complexity: O(K * (V + E) * P / T), where K is the number of candidates, P the number of augmenting paths
+     * of each one and T the number of threads.
+     *
+     * @param network The network, with a maximum flow.
+     * @param delta The capacity to add to each pipe, or 0 to double its capacity.
+     * @return The upgrades, by decreasing gain.
+     */
+    vector<Upgrade> plan(const FlowNetwork& network, long long delta) const;
+
+    /**
+     * @brief Finds the arcs of pipes in every minimum cut of a solved network.
+     *
+     * Time complexity: O(V + E)
+     *
+     * @param network The network, with a maximum flow.
+     * @return The arcs, one per pipe.
+     */
+    static vector<int> findCandidates(const FlowNetwork& network);
+
+private:
+    /**
+     * @brief Upgrades one pipe on a copy of the network and augments the flow.
+     * @param network The network, with a maximum flow.
+     * @param arc The arc of the pipe.
+     * @param delta The capacity to add to the pipe.
+     * @return The result of the upgrade.
+     */
+    static Upgrade evaluate(const FlowNetwork& network, int arc, long long delta);
+
+    /**
+     * @brief Sends flow along shortest augmenting paths until the sink can't be reached, starting from the current flow.
+     * @param network The network.
+     * @return The flow added.
+     */
+    static long long augment(FlowNetwork& network);
+
+    unsigned threads; /**< Number of worker threads. */
+};
+
+#endif //PROJECTDA_UPGRADEPLANNER_H
@@ -1,9 +1,57 @@
 #include "controller/manager.h"
+#include "controller/tracer.h"
+#include "view/batch.h"
 #include "view/menu.h"
-
-int main(){
+int main(int argc, char* argv[]){
+    const string usage = "Usage: watersupply [--trace <file>] [--verify] [--output-dir <directory>] [--output-prefix <prefix>] "
+                         "[--output-extension <extension>] [--batch <small|large> <command> [arguments...]]";
     Manager* manager = new Manager();
+    // --trace <file> records the phases of the run as a Chrome trace, --verify checks the repaired flows of the
+    // failure sweeps against solves from scratch and the --output options name the result files
+    int first = 1;
+    while (argc > first && string(argv[first]).rfind("--", 0) == 0 && string(argv[first]) != "--batch") {
+        const string option = argv[first];
+        if (option == "--verify") {
+            manager->setVerifyRepairs(true);
+            first++;
+            continue;
+        }
+        if (argc <= first + 1) {
+            cerr << usage << endl;
+            delete manager;
+            return EXIT_FAILURE;
+        }
+        const string value = argv[first + 1];
+        if (option == "--trace") Tracer::start(value);
+        else if (option == "--output-dir") manager->getResultWriter().setDirectory(value);
+        else if (option == "--output-prefix") manager->getResultWriter().setPrefix(value);
+        else if (option == "--output-extension") manager->getResultWriter().setExtension(value);
+        else {
+            cerr << usage << endl;
+            delete manager;
+            return EXIT_FAILURE;
+        }
+        first += 2;
+    }
+    if (argc > first && string(argv[first]) == "--batch") {
+        if (argc < first + 3) {
+            cerr << usage << endl;
+            delete manager;
+            return EXIT_FAILURE;
+        }
+        Batch batch(manager);
+        int status = batch.run(argv[first + 1], argv[first + 2], vector<string>(argv + first + 3, argv + argc));
+        if (manager->getRepairMismatches() > 0) {
+            cerr << "Error: " << manager->getRepairMismatches() << " repaired flows were not a maximum flow." << endl;
+            status = EXIT_FAILURE;
+        }
+        delete manager;
+        Tracer::stop();
+        return status;
+    }
     Menu* menu = new Menu(manager);
+    // Leaving the menu deletes the manager, which waits for the result files
     menu->mainMenu();
+    Tracer::stop();
     return 0;
 }
@@ -0,0 +1,45 @@
+/**
+* @file AttributionMatrix.cpp
+* @brief This file contains the implementation of AttributionMatrix.
+ */
+
+// Project headers
+#include "AttributionMatrix.h"
+
+AttributionMatrix::AttributionMatrix(const vector<Vertex*>& reservoirs, const vector<Vertex*>& cities) {
+    this->reservoirs = reservoirs;
+    this->cities = cities;
+    for (int i = 0; i < getNumberOfReservoirs(); i++) {
+        reservoirIndex[reservoirs[i]] = i;
+    }
+    for (int i = 0; i < getNumberOfCities(); i++) {
+        cityIndex[cities[i]] = i;
+    }
+    values.assign(reservoirs.size() * cities.size(), 0);
+}
+
+double AttributionMatrix::getCityTotal(const int city) const {
+    double total = 0;
+    for (int r = 0; r < getNumberOfReservoirs(); r++) {
+        total += get(r, city);
+    }
+    return total;
+}
+
+double AttributionMatrix::getReservoirTotal(const int reservoir) const {
+    double total = 0;
+    for (int c = 0; c < getNumberOfCities(); c++) {
+        total += get(reservoir, c);
+    }
+    return total;
+}
+
+int AttributionMatrix::getReservoirIndex(const Vertex* v) const {
+    const auto it = reservoirIndex.find(v);
+    return it != reservoirIndex.end() ? it->second : -1;
+}
+
+int AttributionMatrix::getCityIndex(const Vertex* v) const {
+    const auto it = cityIndex.find(v);
+    return it != cityIndex.end() ? it->second : -1;
+}
@@ -0,0 +1,114 @@
+#ifndef PROJECTDA_ATTRIBUTIONMATRIX_H
+#define PROJECTDA_ATTRIBUTIONMATRIX_H
+
+/**
+* @file AttributionMatrix.h
+* @brief This file contains the AttributionMatrix header.
+ */
+
+using namespace std;
+// Project headers
+#include "Graph.h"
+// Standard Library Headers
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class AttributionMatrix
+ * @brief Represents how much of the flow that reaches each city comes from each reservoir.
+ *
+ * The values are stored in a dense reservoir x city table, one row per reservoir.
+ */
+class AttributionMatrix {
+public:
+    /**
+     * @brief Creates an empty matrix, without reservoirs or cities.
+     */
+    AttributionMatrix() = default;
+
+    /**
+     * @brief Creates a matrix with every value equal to 0.
+     *
+     * Time Complexity: O(R * C), where R is the number of reservoirs and C the number of cities.
+     *
+     * @param reservoirs The reservoirs, one per row.
+     * @param cities The cities, one per column.
+     */
+    AttributionMatrix(const vector<Vertex*>& reservoirs, const vector<Vertex*>& cities);
+
+    /**
+     * @brief Adds flow from a reservoir to a city.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param reservoir Index of the reservoir.
+     * @param city Index of the city.
+     * @param flow The flow to add.
+     */
+    void add(int reservoir, int city, double flow) { values[reservoir * cities.size() + city] += flow; }
+
+    /**
+     * @brief Gets the flow from a reservoir to a city.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param reservoir Index of the reservoir.
+     * @param city Index of the city.
+     * @return The flow.
+     */
+    double get(int reservoir, int city) const { return values[reservoir * cities.size() + city]; }
+
+    /**
+     * @brief Gets the flow that reaches a city from every reservoir.
+     *
+     * Time Complexity: O(R), where R is the number of reservoirs.
+     *
+     * @param city Index of the city.
+     * @return The flow.
+     */
+    double getCityTotal(int city) const;
+
+    /**
+     * @brief Gets the flow that leaves a reservoir to every city.
+     *
+     * Time Complexity: O(C), where C is the number of cities.
+     *
+     * @param reservoir Index of the reservoir.
+     * @return The flow.
+     */
+    double getReservoirTotal(int reservoir) const;
+
+    /**
+     * @brief Gets the index of a reservoir.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param v Pointer to the reservoir.
+     * @return The index, or -1 if it is not in the matrix.
+     */
+    int getReservoirIndex(const Vertex* v) const;
+
+    /**
+     * @brief Gets the index of a city.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param v Pointer to the city.
+     * @return The index, or -1 if it is not in the matrix.
+     */
+    int getCityIndex(const Vertex* v) const;
+
+    int getNumberOfReservoirs() const { return static_cast<int>(reservoirs.size()); } /**< @brief Gets the number of reservoirs. */
+    int getNumberOfCities() const { return static_cast<int>(cities.size()); } /**< @brief Gets the number of cities. */
+    Vertex* getReservoir(int reservoir) const { return reservoirs[reservoir]; } /**< @brief Gets the reservoir of a row. */
+    Vertex* getCity(int city) const { return cities[city]; } /**< @brief Gets the city of a column. */
+
+private:
+    vector<Vertex*> reservoirs; /**< Reservoir of each row. */
+    vector<Vertex*> cities; /**< City of each column. */
+    unordered_map<const Vertex*, int> reservoirIndex; /**< Row of each reservoir. */
+    unordered_map<const Vertex*, int> cityIndex; /**< Column of each city. */
+    vector<double> values; /**< Flow from each reservoir to each city, row by row. */
+};
+
+#endif //PROJECTDA_ATTRIBUTIONMATRIX_H
@@ -0,0 +1,69 @@
+/**
+* @file CityTable.cpp
+* @brief This file contains the implementation of CityTable.
+ */
+
+// Project headers
+#include "CityTable.h"
+// Standard Library Headers
+#include <algorithm>
+
+int CityTable::add(City* city) {
+    const int i = getNumberOfCities();
+    cities.push_back(city);
+    codes.push_back(city->getCode());
+    demands.push_back(city->getDemand());
+    sinkEdges.push_back(nullptr);
+    index[codes.back()] = i;
+    return i;
+}
+
+void CityTable::clear() {
+    cities.clear();
+    codes.clear();
+    demands.clear();
+    sinkEdges.clear();
+    index.clear();
+}
+
+void CityTable::setDemand(const int city, const int demand) {
+    demands[city] = demand;
+    cities[city]->setDemand(demand);
+}
+
+void CityTable::clearSinkEdges() {
+    fill(sinkEdges.begin(), sinkEdges.end(), nullptr);
+}
+
+int CityTable::getIndex(const string& code) const {
+    const auto it = index.find(code);
+    return it != index.end() ? it->second : -1;
+}
+
+vector<int> CityTable::getSupplied() const {
+    vector<int> supplied(cities.size(), 0);
+    for (size_t i = 0; i < sinkEdges.size(); i++) {
+        if (sinkEdges[i] != nullptr) {
+            supplied[i] = sinkEdges[i]->getCapacity() - sinkEdges[i]->getFlow();
+        }
+    }
+    return supplied;
+}
+
+long long CityTable::computeDeficits(const vector<int>& supplied, vector<int>& deficits, vector<unsigned char>& satisfied) const {
+    const size_t n = demands.size();
+    deficits.resize(n);
+    satisfied.resize(n);
+    const int* demand = demands.data();
+    const int* supply = supplied.data();
+    int* deficit = deficits.data();
+    unsigned char* enough = satisfied.data();
+    long long total = 0;
+    for (size_t i = 0; i < n; i++) {
+        const int missing = demand[i] - supply[i];
+        deficit[i] = max(missing, 0);
+        enough[i] = missing <= 0;
+        total += deficit[i];
+    }
+    return total;
+}
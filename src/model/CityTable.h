@@ -0,0 +1,118 @@
+#ifndef PROJECTDA_CITYTABLE_H
+#define PROJECTDA_CITYTABLE_H
+
+/**
+* @file CityTable.h
+* @brief This file contains the CityTable header.
+ */
+
+using namespace std;
+// Project headers
+#include "Graph.h"
+// Standard Library Headers
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class CityTable
+ * @brief Gives every city a dense index, in import order, and keeps its data in arrays aligned by that index.
+ *
+ * Besides the code and demand, the table keeps the edge from each city to the super sink while the graph has one,
+ * so the flow supplied to every city can be read without searching the graph.
+ */
+class CityTable {
+public:
+    /**
+     * @brief Adds a city at the end of the table.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param city Pointer to the city.
+     * @return The index of the city.
+     */
+    int add(City* city);
+
+    /**
+     * @brief Removes every city.
+     *
+     * Time Complexity: O(C), where C is the number of cities.
+     */
+    void clear();
+
+    /**
+     * @brief Sets the edge from a city to the super sink.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param city Index of the city.
+     * @param e Pointer to the edge.
+     */
+    void setSinkEdge(int city, Edge* e) { sinkEdges[city] = e; }
+
+    /**
+     * @brief Sets the demand of a city, in the table and in the city.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param city Index of the city.
+     * @param demand The new demand.
+     */
+    void setDemand(int city, int demand);
+
+    /**
+     * @brief Forgets the edges to the super sink, after it was removed.
+     *
+     * Time Complexity: O(C), where C is the number of cities.
+     */
+    void clearSinkEdges();
+
+    /**
+     * @brief Gets the index of a city.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param code The code of the city.
+     * @return The index, or -1 if there is no city with that code.
+     */
+    int getIndex(const string& code) const;
+
+    /**
+     * @brief Gets the flow that reaches each city through its edge to the super sink.
+     *
+     * Time Complexity: O(C), where C is the number of cities.
+     *
+     * @return The flow of each city, 0 for the cities without an edge to the super sink.
+     */
+    vector<int> getSupplied() const;
+
+    /**
+     * @brief Compares the flow supplied to each city with its demand.
+     *
+     * Every array is indexed by city and the loop has no branches, so the compiler can vectorize it.
+     *
+     * Time Complexity: O(C), where C is the number of cities.
+     *
+     * @param supplied The flow supplied to each city.
+     * @param deficits Set to the demand each city doesn't get, 0 if it gets enough.
+     * @param satisfied Set to 1 for the cities that get enough flow, 0 otherwise.
+     * @return The sum of the deficits.
+     */
+    long long computeDeficits(const vector<int>& supplied, vector<int>& deficits, vector<unsigned char>& satisfied) const;
+
+    int getNumberOfCities() const { return static_cast<int>(cities.size()); } /**< @brief Gets the number of cities. */
+    City* getCity(int city) const { return cities[city]; } /**< @brief Gets the city with an index. */
+    const string& getCode(int city) const { return codes[city]; } /**< @brief Gets the code of a city. */
+    int getDemand(int city) const { return demands[city]; } /**< @brief Gets the demand of a city. */
+    const vector<int>& getDemands() const { return demands; } /**< @brief Gets the demand of every city. */
+    Edge* getSinkEdge(int city) const { return sinkEdges[city]; } /**< @brief Gets the edge from a city to the super sink, or nullptr. */
+
+private:
+    vector<City*> cities; /**< City with each index. */
+    vector<string> codes; /**< Code of each city. */
+    vector<int> demands; /**< Demand of each city. */
+    vector<Edge*> sinkEdges; /**< Edge from each city to the super sink, or nullptr. */
+    unordered_map<string, int> index; /**< Index of the city with each code. */
+};
+
+#endif //PROJECTDA_CITYTABLE_H
@@ -0,0 +1,40 @@
+#ifndef PROJECTDA_CRITICALITY_H
+#define PROJECTDA_CRITICALITY_H
+
+/**
+* @file Criticality.h
+* @brief This file contains the Criticality header.
+ */
+
+using namespace std;
+// Standard Library Headers
+#include <string>
+#include <vector>
+
+/**
+ * @struct Criticality
+ * @brief The stations and pipes whose removal alone cuts cities off from every reservoir.
+ *
+ * This only depends on the topology of the network: a station or pipe cuts a city off when every route from a
+ * reservoir to the city passes through it, whatever the capacities. Removing any other single station or pipe can
+ * still lower the flow of a city, but never to zero.
+ */
+struct Criticality {
+    /**
+     * @struct Element
+     * @brief A station or pipe that cuts cities off.
+     */
+    struct Element {
+        string origin; /**< Code of the station, or of the origin of the pipe. */
+        string destination; /**< Code of the destination of the pipe, empty for a station. */
+        vector<string> cities; /**< Codes of the cities it cuts off. */
+        long long demand; /**< Total demand of those cities. */
+    };
+
+    vector<Element> stations; /**< Stations that cut cities off, by decreasing demand. */
+    vector<Element> pipes; /**< Pipes that cut cities off, by decreasing demand. */
+    vector<string> idleStations; /**< Stations on no route from a reservoir to a city. */
+    vector<string> unreachableCities; /**< Cities no reservoir reaches. */
+};
+
+#endif //PROJECTDA_CRITICALITY_H
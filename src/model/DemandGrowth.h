@@ -0,0 +1,51 @@
+#ifndef PROJECTDA_DEMANDGROWTH_H
+#define PROJECTDA_DEMANDGROWTH_H
+
+/**
+* @file DemandGrowth.h
+* @brief This file contains the DemandGrowth header.
+ */
+
+using namespace std;
+// Standard Library Headers
+#include <string>
+#include <vector>
+
+/**
+ * @struct DemandGrowth
+ * @brief The largest factor every demand can be multiplied by while every city still gets enough water.
+ *
+ * The factor is the exact fraction numerator / denominator. Beyond it the binding cut can't carry the demand of the
+ * cities behind it: its pipes, with the max delivery of the reservoirs where it binds, have a total capacity equal
+ * to the factor times the demand of those cities.
+ */
+struct DemandGrowth {
+    /**
+     * @struct Pipe
+     * @brief A pipe of the binding cut.
+     */
+    struct Pipe {
+        string origin; /**< Code of the origin, or of the reservoir for a max delivery. */
+        string destination; /**< Code of the destination, or "(max delivery)" for the max delivery of a reservoir. */
+        int capacity; /**< Capacity of the pipe, or the max delivery. */
+    };
+
+    long long numerator = 0; /**< Numerator of the factor. */
+    long long denominator = 0; /**< Denominator of the factor, 0 when there is no demand to scale. */
+    vector<Pipe> cut; /**< Pipes of the binding cut. */
+    vector<string> cities; /**< Codes of the cities behind the binding cut. */
+
+    /**
+     * @brief Checks if the demands can grow without limit, because there is no demand.
+     * @return True if there is no demand, false otherwise.
+     */
+    bool isUnbounded() const { return denominator == 0; }
+
+    /**
+     * @brief Gets the factor as a floating point number.
+     * @return The factor.
+     */
+    double getFactor() const { return static_cast<double>(numerator) / static_cast<double>(denominator); }
+};
+
+#endif //PROJECTDA_DEMANDGROWTH_H
@@ -19,6 +19,10 @@ int Edge::getCapacity() const{
     return this->capacity;
 }
 
+void Edge::setCapacity(const int capacity) {
+    this->capacity = capacity;
+}
+
 const string& Edge::getType() const {
     return type;
 }
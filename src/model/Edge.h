@@ -96,6 +96,15 @@ public:
      */
     int getCapacity() const;
 
+    /**
+     * @brief Sets the capacity of the edge.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param capacity The new capacity of the edge.
+     */
+    void setCapacity(int capacity);
+
     /**
      * @brief Retrieves the type of the edge.
      *
@@ -0,0 +1,53 @@
+/**
+* @file FlowDecomposition.cpp
+* @brief This file contains the implementation of FlowDecomposition.
+ */
+
+// Project headers
+#include "FlowDecomposition.h"
+
+void FlowDecomposition::addPath(const vector<Vertex*>& vertexes, const int flow) {
+    arena.insert(arena.end(), vertexes.begin(), vertexes.end());
+    offsets.push_back(static_cast<int>(arena.size()));
+    flows.push_back(flow);
+}
+
+void FlowDecomposition::clear() {
+    arena.clear();
+    offsets.assign(1, 0);
+    flows.clear();
+}
+
+long long FlowDecomposition::getTotalFlow() const {
+    long long total = 0;
+    for (const int flow : flows) {
+        total += flow;
+    }
+    return total;
+}
+
+vector<int> FlowDecomposition::getPathsThrough(const Vertex* v) const {
+    vector<int> result;
+    for (int path = 0; path < getNumberOfPaths(); path++) {
+        for (int i = offsets[path]; i < offsets[path + 1]; i++) {
+            if (arena[i] == v) {
+                result.push_back(path);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+vector<int> FlowDecomposition::getPathsThrough(const Edge* e) const {
+    vector<int> result;
+    for (int path = 0; path < getNumberOfPaths(); path++) {
+        for (int i = offsets[path] + 1; i < offsets[path + 1]; i++) {
+            if (arena[i - 1] == e->getOrigin() && arena[i] == e->getDest()) {
+                result.push_back(path);
+                break;
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,84 @@
+#ifndef PROJECTDA_FLOWDECOMPOSITION_H
+#define PROJECTDA_FLOWDECOMPOSITION_H
+
+/**
+* @file FlowDecomposition.h
+* @brief This file contains the FlowDecomposition header.
+ */
+
+using namespace std;
+// Project headers
+#include "Graph.h"
+// Standard Library Headers
+#include <vector>
+
+/**
+ * @class FlowDecomposition
+ * @brief Represents a flow split into weighted paths from a reservoir to a city.
+ *
+ * The vertexes of every path are stored one after the other in a single arena and the paths are delimited by
+ * offsets, so path i is arena[offsets[i]] ... arena[offsets[i + 1] - 1], from the reservoir to the city. The super
+ * source and super sink are not part of the paths.
+ */
+class FlowDecomposition {
+public:
+    /**
+     * @brief Adds a path at the end of the decomposition.
+     *
+     * Time Complexity: O(L), where L is the number of vertexes of the path.
+     *
+     * @param vertexes The vertexes of the path, from the reservoir to the city.
+     * @param flow The flow that goes through the path.
+     */
+    void addPath(const vector<Vertex*>& vertexes, int flow);
+
+    /**
+     * @brief Removes every path.
+     *
+     * Time Complexity: O(1)
+     */
+    void clear();
+
+    /**
+     * @brief Gets the total flow of the paths.
+     *
+     * Time Complexity: O(P), where P is the number of paths.
+     *
+     * @return The sum of the flow of every path.
+     */
+    long long getTotalFlow() const;
+
+    /**
+     * @brief Gets the paths that go through a vertex.
+     *
+     * Time Complexity: O(A), where A is the size of the arena.
+     *
+     * @param v Pointer to the vertex.
+     * @return The indexes of the paths, in increasing order.
+     */
+    vector<int> getPathsThrough(const Vertex* v) const;
+
+    /**
+     * @brief Gets the paths that go through a pipe, in the direction of the edge.
+     *
+     * Time Complexity: O(A), where A is the size of the arena.
+     *
+     * @param e Pointer to the edge.
+     * @return The indexes of the paths, in increasing order.
+     */
+    vector<int> getPathsThrough(const Edge* e) const;
+
+    int getNumberOfPaths() const { return static_cast<int>(flows.size()); } /**< @brief Gets the number of paths. */
+    int getFlow(int path) const { return flows[path]; } /**< @brief Gets the flow of a path. */
+    int getLength(int path) const { return offsets[path + 1] - offsets[path]; } /**< @brief Gets the number of vertexes of a path. */
+    Vertex* getVertex(int path, int i) const { return arena[offsets[path] + i]; } /**< @brief Gets the i-th vertex of a path. */
+    Vertex* getReservoir(int path) const { return arena[offsets[path]]; } /**< @brief Gets the reservoir a path starts at. */
+    Vertex* getCity(int path) const { return arena[offsets[path + 1] - 1]; } /**< @brief Gets the city a path ends at. */
+
+private:
+    vector<Vertex*> arena; /**< Vertexes of every path, one path after the other. */
+    vector<int> offsets = {0}; /**< Start of each path in the arena, followed by the size of the arena. */
+    vector<int> flows; /**< Flow of each path. */
+};
+
+#endif //PROJECTDA_FLOWDECOMPOSITION_H
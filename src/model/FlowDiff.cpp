@@ -0,0 +1,25 @@
+/**
+* @file FlowDiff.cpp
+* @brief This file contains the implementation of FlowDiff.
+ */
+
+// Project headers
+#include "FlowDiff.h"
+
+FlowDiff computeFlowDiff(const vector<pair<string,int>>& before, const vector<pair<string,int>>& after) {
+    FlowDiff diff;
+    const size_t n = before.size();
+    diff.before.resize(n);
+    diff.after.resize(n);
+    diff.decline.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        const int beforeFlow = before[i].second;
+        const int afterFlow = i < after.size() ? after[i].second : 0;
+        diff.before[i] = beforeFlow;
+        diff.after[i] = afterFlow;
+        diff.beforeTotal += beforeFlow;
+        diff.afterTotal += afterFlow;
+        diff.decline[i] = beforeFlow == 0 ? 0 : static_cast<double>(beforeFlow - afterFlow) / beforeFlow * 100;
+    }
+    return diff;
+}
@@ -0,0 +1,56 @@
+#ifndef PROJECTDA_FLOWDIFF_H
+#define PROJECTDA_FLOWDIFF_H
+
+/**
+* @file FlowDiff.h
+* @brief This file contains the FlowDiff header.
+ */
+
+using namespace std;
+// Standard Library Headers
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct FlowDiff
+ * @brief Comparison of the flow of every city before and after a change in the network.
+ *
+ * Every vector is indexed like the city flows it was computed from.
+ */
+struct FlowDiff {
+    long long beforeTotal = 0; /**< Total flow before the change. */
+    long long afterTotal = 0; /**< Total flow after the change. */
+    vector<int> before; /**< Flow of each city before the change. */
+    vector<int> after; /**< Flow of each city after the change. */
+    vector<double> decline; /**< Percentage of its flow each city lost, 0 for the cities that had no flow. */
+
+    /**
+     * @brief Checks if the change affected the total flow.
+     * @return True if the total flow changed, false otherwise.
+     */
+    bool isAffected() const { return beforeTotal != afterTotal; }
+
+    /**
+     * @brief Gets the percentage change of the flow of a city, negative when it lost flow.
+     * @param city Index of the city.
+     * @return The percentage change, 0 for a city that had no flow.
+     */
+    double getChange(size_t city) const { return before[city] == 0 ? 0 : -decline[city]; }
+};
+
+/**
+ * @brief Compares the flow of every city before and after a change.
+ *
+ * Both vectors must have the cities in the same order, as returned by Manager::getCityFlows, so the flows of a city
+ * are found by index instead of searching by code.
+ *
+ * Time Complexity: O(C), where C is the number of cities.
+ *
+ * @param before The flow of each city before the change.
+ * @param after The flow of each city after the change.
+ * @return The comparison.
+ */
+FlowDiff computeFlowDiff(const vector<pair<string,int>>& before, const vector<pair<string,int>>& after);
+
+#endif //PROJECTDA_FLOWDIFF_H
@@ -0,0 +1,83 @@
+/**
+* @file FlowMetrics.cpp
+* @brief This file contains the implementation of FlowMetrics.
+ */
+
+// Project headers
+#include "FlowMetrics.h"
+// Standard Library Headers
+#include <algorithm>
+#include <climits>
+
+/**
+ * @brief Selects the nearest rank percentile of some values, reordering them.
+ * @param values The values, not empty.
+ * @param percent The percentile, from 1 to 100.
+ * @return The value at that rank.
+ */
+static long long selectPercentile(vector<long long>& values, const long long percent) {
+    const size_t rank = (values.size() * percent + 99) / 100;
+    const auto nth = values.begin() + static_cast<long>(max<size_t>(rank, 1) - 1);
+    nth_element(values.begin(), nth, values.end());
+    return *nth;
+}
+
+/**
+ * @brief Gets the variance from the sum and sum of squares of some values.
+ * @param n Number of values.
+ * @param sum Sum of the values.
+ * @param sumSquares Sum of the squares of the values.
+ * @return The population variance.
+ */
+static double getVariance(const long long n, const long long sum, const long long sumSquares) {
+    // n * sum(x^2) - sum(x)^2 avoids the cancellation of sum(x^2) / n - mean^2, long double keeps the products from overflowing
+    const long double numerator = static_cast<long double>(n) * sumSquares - static_cast<long double>(sum) * sum;
+    return static_cast<double>(max<long double>(numerator, 0) / (static_cast<long double>(n) * n));
+}
+
+FlowMetrics computeFlowMetrics(const vector<long long>& flows, const vector<long long>& capacities) {
+    FlowMetrics metrics;
+    const size_t n = flows.size();
+    if (n == 0) return metrics;
+
+    const long long* flow = flows.data();
+    const long long* capacity = capacities.data();
+    long long sumFlow = 0, sumSquaresFlow = 0, minFlow = LLONG_MAX, maxFlow = LLONG_MIN;
+    long long sumSlack = 0, sumSquaresSlack = 0, minSlack = LLONG_MAX, maxSlack = LLONG_MIN;
+    for (size_t i = 0; i < n; i++) {
+        const long long f = flow[i];
+        const long long s = capacity[i] - f;
+        sumFlow += f;
+        sumSquaresFlow += f * f;
+        minFlow = min(minFlow, f);
+        maxFlow = max(maxFlow, f);
+        sumSlack += s;
+        sumSquaresSlack += s * s;
+        minSlack = min(minSlack, s);
+        maxSlack = max(maxSlack, s);
+    }
+
+    const long long count = static_cast<long long>(n);
+    metrics.count = count;
+    metrics.totalFlow = sumFlow;
+    metrics.minFlow = minFlow;
+    metrics.maxFlow = maxFlow;
+    metrics.meanFlow = static_cast<double>(sumFlow) / static_cast<double>(count);
+    metrics.varianceFlow = getVariance(count, sumFlow, sumSquaresFlow);
+    metrics.minSlack = minSlack;
+    metrics.maxSlack = maxSlack;
+    metrics.meanSlack = static_cast<double>(sumSlack) / static_cast<double>(count);
+    metrics.varianceSlack = getVariance(count, sumSlack, sumSquaresSlack);
+
+    vector<long long> values(flows);
+    metrics.medianFlow = selectPercentile(values, 50);
+    metrics.p90Flow = selectPercentile(values, 90);
+    metrics.p99Flow = selectPercentile(values, 99);
+    for (size_t i = 0; i < n; i++) {
+        values[i] = capacity[i] - flow[i];
+    }
+    metrics.medianSlack = selectPercentile(values, 50);
+    metrics.p90Slack = selectPercentile(values, 90);
+    metrics.p99Slack = selectPercentile(values, 99);
+    return metrics;
+}
@@ -0,0 +1,55 @@
+#ifndef PROJECTDA_FLOWMETRICS_H
+#define PROJECTDA_FLOWMETRICS_H
+
+/**
+* @file FlowMetrics.h
+* @brief This file contains the FlowMetrics header.
+ */
+
+using namespace std;
+// Standard Library Headers
+#include <vector>
+
+/**
+ * @struct FlowMetrics
+ * @brief Statistics of the flow of a set of pipes and of their slack, the capacity they don't use.
+ *
+ * Percentiles use the nearest rank, so they are always values of some pipe.
+ */
+struct FlowMetrics {
+    long long count = 0; /**< Number of pipes. */
+    long long totalFlow = 0; /**< Sum of the flow of every pipe. */
+
+    long long minFlow = 0; /**< Smallest flow. */
+    long long maxFlow = 0; /**< Largest flow. */
+    double meanFlow = 0; /**< Average flow. */
+    double varianceFlow = 0; /**< Population variance of the flow. */
+    long long medianFlow = 0; /**< 50th percentile of the flow. */
+    long long p90Flow = 0; /**< 90th percentile of the flow. */
+    long long p99Flow = 0; /**< 99th percentile of the flow. */
+
+    long long minSlack = 0; /**< Smallest difference between capacity and flow. */
+    long long maxSlack = 0; /**< Largest difference between capacity and flow. */
+    double meanSlack = 0; /**< Average difference between capacity and flow. */
+    double varianceSlack = 0; /**< Population variance of the difference between capacity and flow. */
+    long long medianSlack = 0; /**< 50th percentile of the difference between capacity and flow. */
+    long long p90Slack = 0; /**< 90th percentile of the difference between capacity and flow. */
+    long long p99Slack = 0; /**< 99th percentile of the difference between capacity and flow. */
+};
+
+/**
+ * @brief Computes the statistics of the flow and slack of a set of pipes.
+ *
+ * The sums, sums of squares, minimums and maximums are computed in a single pass over the arrays, with 64-bit
+ * integers so the mean and variance are exact up to the final division. The loop has no branches, so the compiler
+ * can vectorize it. The percentiles are then selected with nth_element on a copy of the values.
+ *
+ * Time Complexity: O(n)
+ *
+ * @param flows Flow of each pipe.
+ * @param capacities Capacity of each pipe, with the same size as flows.
+ * @return The statistics, with every value 0 if there are no pipes.
+ */
+FlowMetrics computeFlowMetrics(const vector<long long>& flows, const vector<long long>& capacities);
+
+#endif //PROJECTDA_FLOWMETRICS_H
@@ -0,0 +1,406 @@
+/**
+* @file FlowNetwork.cpp
+* @brief This file contains the implementation of FlowNetwork.
+ */
+
+// Project headers
+#include "FlowNetwork.h"
+// Standard Library Headers
+#include <algorithm>
+#include <functional>
+
+void FlowNetwork::clear() {
+    graph = nullptr;
+    n = 0;
+    source = -1;
+    sink = -1;
+    vertices.clear();
+    vertexIndex.clear();
+    edgeArc.clear();
+    first.clear();
+    head.clear();
+    rev.clear();
+    capacity.clear();
+    baseCapacity.clear();
+    residual.clear();
+    edges.clear();
+    prunedEdges.clear();
+    changedArcs.clear();
+}
+
+bool FlowNetwork::isBuilt() const {
+    return n > 0;
+}
+
+void FlowNetwork::build(Graph* graph, Vertex* superSource, Vertex* superSink) {
+    clear();
+    this->graph = graph;
+    vertices = graph->getVertexSet();
+    n = static_cast<int>(vertices.size());
+    vertexIndex.reserve(n);
+    for (int i = 0; i < n; i++) {
+        vertexIndex[vertices[i]] = i;
+    }
+    source = vertexIndex.at(superSource);
+    sink = vertexIndex.at(superSink);
+
+    // Residual edges added while augmenting are represented by the reverse arcs
+    auto isPipe = [&](const Edge* e) {
+        return e->getType() == "normal" || e->getOrigin() == superSource || e->getDest() == superSink;
+    };
+
+    struct ArcPair {
+        int tail, head;
+        Edge* forward;
+        Edge* backward;
+    };
+    vector<ArcPair> pairs;
+    for (const auto v : vertices) {
+        for (const auto e : v->getAdj()) {
+            if (!isPipe(e)) continue;
+            Edge* partner = e->getReverseEdge();
+            if (partner != nullptr && !isPipe(partner)) partner = nullptr;
+            if (partner != nullptr && less<const Edge*>()(partner, e)) continue; // Pair already added
+            pairs.push_back({vertexIndex.at(e->getOrigin()), vertexIndex.at(e->getDest()), e, partner});
+        }
+    }
+
+    // Pipes touching a vertex on no route from the source to the sink can never carry flow, so they get no arcs.
+    // The arcs from the source and to the sink are kept, so every reservoir and city has one.
+    vector<int> firstOut(n + 1, 0);
+    for (const auto& p : pairs) {
+        firstOut[p.tail + 1]++;
+        if (p.backward != nullptr) firstOut[p.head + 1]++;
+    }
+    for (int v = 0; v < n; v++) {
+        firstOut[v + 1] += firstOut[v];
+    }
+    vector<int> out(firstOut[n]);
+    vector<int> nextOut(firstOut.begin(), firstOut.end() - 1);
+    for (const auto& p : pairs) {
+        out[nextOut[p.tail]++] = p.head;
+        if (p.backward != nullptr) out[nextOut[p.head]++] = p.tail;
+    }
+    const vector<unsigned char> relevant = findRelevantVertexes(firstOut, out);
+    vector<int> degree(n + 1, 0);
+    size_t kept = 0;
+    for (const auto& p : pairs) {
+        if (p.tail != source && p.head != sink && (!relevant[p.tail] || !relevant[p.head])) {
+            prunedEdges.push_back(p.forward);
+            if (p.backward != nullptr) prunedEdges.push_back(p.backward);
+            continue;
+        }
+        pairs[kept++] = p;
+        degree[p.tail]++;
+        degree[p.head]++;
+    }
+    pairs.resize(kept);
+
+    first.assign(n + 1, 0);
+    for (int v = 0; v < n; v++) {
+        first[v + 1] = first[v] + degree[v];
+    }
+    const int m = first[n];
+    head.assign(m, 0);
+    rev.assign(m, 0);
+    capacity.assign(m, 0);
+    baseCapacity.assign(m, 0);
+    residual.assign(m, 0);
+    edges.assign(m, nullptr);
+    edgeArc.reserve(m);
+
+    vector<int> next(first.begin(), first.end() - 1);
+    for (const auto& p : pairs) {
+        const int a = next[p.tail]++;
+        const int b = next[p.head]++;
+        head[a] = p.head;
+        head[b] = p.tail;
+        rev[a] = b;
+        rev[b] = a;
+        edges[a] = p.forward;
+        edges[b] = p.backward;
+        edgeArc[p.forward] = a;
+        baseCapacity[a] = p.forward->getCapacity();
+        residual[a] = p.forward->getFlow();
+        if (p.backward != nullptr) {
+            edgeArc[p.backward] = b;
+            baseCapacity[b] = p.backward->getCapacity();
+            residual[b] = p.backward->getFlow();
+        }
+        else {
+            residual[b] = p.forward->getCapacity() - p.forward->getFlow();
+        }
+        capacity[a] = baseCapacity[a];
+        capacity[b] = baseCapacity[b];
+    }
+
+    // Disabled vertexes and pipes are arcs with capacity 0
+    for (int a = 0; a < m; a++) {
+        if (baseCapacity[a] > 0 && !isArcEnabled(a)) {
+            setCapacity(a, 0);
+        }
+    }
+    changedArcs.clear();
+}
+
+vector<unsigned char> FlowNetwork::findRelevantVertexes(const vector<int>& firstOut, const vector<int>& out) const {
+    // Iterative Tarjan from the source. Components are completed in reverse topological order, so whether the
+    // components a component leads to reach the sink is known when it is completed.
+    vector<int> order(n, -1), low(n, 0), component(n, -1), stack;
+    vector<unsigned char> reachesSink;
+    vector<pair<int,int>> calls = {{source, firstOut[source]}};
+    int time = 0;
+    order[source] = low[source] = time++;
+    stack.push_back(source);
+    while (!calls.empty()) {
+        auto& [v, next] = calls.back();
+        if (next < firstOut[v + 1]) {
+            const int w = out[next++];
+            if (order[w] < 0) {
+                order[w] = low[w] = time++;
+                stack.push_back(w);
+                calls.emplace_back(w, firstOut[w]);
+            }
+            else if (component[w] < 0) {
+                low[v] = min(low[v], order[w]);
+            }
+            continue;
+        }
+        const int u = v;
+        calls.pop_back();
+        if (!calls.empty()) low[calls.back().first] = min(low[calls.back().first], low[u]);
+        if (low[u] != order[u]) continue;
+
+        const int c = static_cast<int>(reachesSink.size());
+        size_t start = stack.size();
+        do {
+            component[stack[--start]] = c;
+        } while (stack[start] != u);
+        bool reaches = false;
+        for (size_t i = start; i < stack.size() && !reaches; i++) {
+            const int x = stack[i];
+            reaches = x == sink;
+            for (int a = firstOut[x]; a < firstOut[x + 1] && !reaches; a++) {
+                const int w = component[out[a]];
+                reaches = w != c && reachesSink[w];
+            }
+        }
+        reachesSink.push_back(reaches);
+        stack.resize(start);
+    }
+
+    vector<unsigned char> relevant(n, 0);
+    for (int v = 0; v < n; v++) {
+        relevant[v] = component[v] >= 0 && reachesSink[component[v]];
+    }
+    return relevant;
+}
+
+void FlowNetwork::build(const int n, const int source, const int sink, const vector<Pipe>& pipes, vector<int>& pipeArcs) {
+    clear();
+    this->n = n;
+    this->source = source;
+    this->sink = sink;
+    vertices.assign(n, nullptr);
+
+    first.assign(n + 1, 0);
+    for (const auto& p : pipes) {
+        first[p.tail + 1]++;
+        first[p.head + 1]++;
+    }
+    for (int v = 0; v < n; v++) {
+        first[v + 1] += first[v];
+    }
+    const int m = first[n];
+    head.assign(m, 0);
+    rev.assign(m, 0);
+    capacity.assign(m, 0);
+    residual.assign(m, 0);
+    edges.assign(m, nullptr);
+
+    pipeArcs.resize(pipes.size());
+    vector<int> next(first.begin(), first.end() - 1);
+    for (size_t i = 0; i < pipes.size(); i++) {
+        const auto& p = pipes[i];
+        const int a = next[p.tail]++;
+        const int b = next[p.head]++;
+        head[a] = p.head;
+        head[b] = p.tail;
+        rev[a] = b;
+        rev[b] = a;
+        capacity[a] = residual[a] = p.capacity;
+        capacity[b] = residual[b] = p.reverseCapacity;
+        pipeArcs[i] = a;
+    }
+    baseCapacity = capacity;
+}
+
+bool FlowNetwork::isArcEnabled(const int arc) const {
+    const Edge* e = edges[arc];
+    if (e == nullptr) return true;
+    return e->isEnabled() && e->getOrigin()->isEnabled() && e->getDest()->isEnabled();
+}
+
+void FlowNetwork::writeFlows() const {
+    for (Edge* e : prunedEdges) {
+        e->setFlow(e->getCapacity());
+    }
+    for (int a = 0; a < getNumberOfArcs(); a++) {
+        Edge* e = edges[a];
+        if (e == nullptr) continue;
+        const long long flow = getFlow(a);
+        e->setFlow(static_cast<int>(baseCapacity[a] - flow));
+        if (edges[rev[a]] != nullptr) continue; // Reverse is the other direction of the pipe
+
+        Edge* residualEdge = e->getReverseEdge();
+        if (residualEdge == nullptr && flow > 0) {
+            residualEdge = graph->addEdge(e->getDest(), e->getOrigin(), e->getCapacity(), "residual");
+            if (residualEdge == nullptr) continue;
+            residualEdge->setReverseEdge(e);
+            e->setReverseEdge(residualEdge);
+        }
+        if (residualEdge != nullptr) {
+            residualEdge->setFlow(static_cast<int>(flow));
+        }
+    }
+}
+
+void FlowNetwork::setCapacity(const int arc, const long long newCapacity) {
+    const long long flow = getFlow(arc);
+    capacity[arc] = newCapacity;
+    changedArcs.push_back(arc);
+    changedArcs.push_back(rev[arc]);
+    if (flow <= newCapacity) {
+        residual[arc] = newCapacity - flow;
+        return;
+    }
+    // Keep only the flow that fits and return the rest to the terminals
+    const long long extra = flow - newCapacity;
+    residual[arc] = 0;
+    residual[rev[arc]] -= extra;
+    returnExcess(getTail(arc), extra);
+    returnDeficit(head[arc], extra);
+}
+
+void FlowNetwork::setBaseCapacity(const int arc, const long long newCapacity) {
+    baseCapacity[arc] = newCapacity;
+    setCapacity(arc, isArcEnabled(arc) ? newCapacity : 0);
+}
+
+void FlowNetwork::returnExcess(const int v, const long long amount) {
+    vector<pair<int, long long>> stack = {{v, amount}};
+    while (!stack.empty()) {
+        auto [u, left] = stack.back();
+        stack.pop_back();
+        if (u == source) continue;
+        for (int a = first[u]; a < first[u + 1] && left > 0; a++) {
+            // rev[a] is an arc arriving at u
+            const long long incoming = getFlow(rev[a]);
+            if (incoming <= 0) continue;
+            const long long d = min(left, incoming);
+            push(a, d);
+            changedArcs.push_back(a);
+            changedArcs.push_back(rev[a]);
+            stack.emplace_back(head[a], d);
+            left -= d;
+        }
+    }
+}
+
+void FlowNetwork::returnDeficit(const int v, const long long amount) {
+    vector<pair<int, long long>> stack = {{v, amount}};
+    while (!stack.empty()) {
+        auto [u, left] = stack.back();
+        stack.pop_back();
+        if (u == sink) continue;
+        for (int a = first[u]; a < first[u + 1] && left > 0; a++) {
+            const long long outgoing = getFlow(a);
+            if (outgoing <= 0) continue;
+            const long long d = min(left, outgoing);
+            push(rev[a], d);
+            changedArcs.push_back(a);
+            changedArcs.push_back(rev[a]);
+            stack.emplace_back(head[a], d);
+            left -= d;
+        }
+    }
+}
+
+void FlowNetwork::refreshVertex(Vertex* v) {
+    const auto it = vertexIndex.find(v);
+    if (it == vertexIndex.end()) return;
+    const int u = it->second;
+    for (int a = first[u]; a < first[u + 1]; a++) {
+        setCapacity(a, isArcEnabled(a) ? baseCapacity[a] : 0);
+        setCapacity(rev[a], isArcEnabled(rev[a]) ? baseCapacity[rev[a]] : 0);
+    }
+}
+
+void FlowNetwork::refreshEdge(const Edge* e) {
+    const int a = getArc(e);
+    if (a < 0) return;
+    setCapacity(a, isArcEnabled(a) ? baseCapacity[a] : 0);
+    setCapacity(rev[a], isArcEnabled(rev[a]) ? baseCapacity[rev[a]] : 0);
+}
+
+vector<int> FlowNetwork::takeChangedArcs() {
+    vector<int> changed;
+    changed.swap(changedArcs);
+    return changed;
+}
+
+long long FlowNetwork::getFlowValue() const {
+    long long value = 0;
+    for (int a = first[source]; a < first[source + 1]; a++) {
+        value += getFlow(a);
+    }
+    return value;
+}
+
+void FlowNetwork::clearFlow() {
+    residual = capacity;
+    changedArcs.clear();
+}
+
+vector<unsigned char> FlowNetwork::getSourceSide() const {
+    vector<unsigned char> reached(n, 0);
+    vector<int> queue = {source};
+    reached[source] = 1;
+    for (size_t i = 0; i < queue.size(); i++) {
+        const int u = queue[i];
+        for (int a = first[u]; a < first[u + 1]; a++) {
+            if (residual[a] > 0 && !reached[head[a]]) {
+                reached[head[a]] = 1;
+                queue.push_back(head[a]);
+            }
+        }
+    }
+    return reached;
+}
+
+vector<unsigned char> FlowNetwork::getSinkSide() const {
+    vector<unsigned char> reached(n, 0);
+    vector<int> queue = {sink};
+    reached[sink] = 1;
+    for (size_t i = 0; i < queue.size(); i++) {
+        const int v = queue[i];
+        for (int a = first[v]; a < first[v + 1]; a++) {
+            // rev[a] arrives at v
+            if (residual[rev[a]] > 0 && !reached[head[a]]) {
+                reached[head[a]] = 1;
+                queue.push_back(head[a]);
+            }
+        }
+    }
+    return reached;
+}
+
+int FlowNetwork::getIndex(const Vertex* v) const {
+    const auto it = vertexIndex.find(v);
+    return it == vertexIndex.end() ? -1 : it->second;
+}
+
+int FlowNetwork::getArc(const Edge* e) const {
+    const auto it = edgeArc.find(e);
+    return it == edgeArc.end() ? -1 : it->second;
+}
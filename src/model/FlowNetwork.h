@@ -0,0 +1,317 @@
+#ifndef PROJECTDA_FLOWNETWORK_H
+#define PROJECTDA_FLOWNETWORK_H
+
+/**
+* @file FlowNetwork.h
+* @brief This file contains the FlowNetwork header.
+ */
+
+using namespace std;
+// Project headers
+#include "Graph.h"
+// Standard Library Headers
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class FlowNetwork
+ * @brief Represents a compact residual network built from the graph.
+ *
+ * The vertexes of the graph are numbered from 0 to n-1 (in vertex set order) and the arcs are stored in forward-star
+ * order, so the arcs leaving a vertex are contiguous. Every arc keeps the index of its reverse arc: a pipe with
+ * Direction=1 becomes two arcs that are the reverse of each other, any other pipe gets a reverse arc with capacity 0.
+ * Arcs created from a pipe keep a pointer to its Edge so the flow can be written back to the graph.
+ *
+ * Pipes touching a vertex that is on no route from the super source to the super sink, like a station that only
+ * leads to dead ends, get no arcs, which shrinks every solve on the network. Their vertexes keep an index, and every
+ * reservoir and city keeps its arc from the super source or to the super sink.
+ *
+ * The residual values follow the graph convention, where the flow stored in an Edge is its residual capacity.
+ */
+class FlowNetwork {
+public:
+    /**
+     * @struct Pipe
+     * @brief A pair of opposite arcs of a network built without a graph.
+     */
+    struct Pipe {
+        int tail; /**< Origin of the arc. */
+        int head; /**< Destination of the arc. */
+        long long capacity; /**< Capacity of the arc. */
+        long long reverseCapacity; /**< Capacity of the reverse arc. */
+    };
+
+    /**
+     * @brief Builds the network from a graph that already has the super source and super sink.
+     *
+     * The residual capacity of each arc is read from the flow stored in its Edge, so the graph must be in the
+     * state left by the max-flow initialization (flow equal to capacity) or by a previous solve. Residual edges
+     * created while augmenting are not arcs of the network, they are represented by the reverse arcs.
+     * Disabled vertexes and pipes get capacity 0. The vertexes on a route from the source to the sink are found
+     * with the strongly connected components of the pipes, whatever their capacity or enabled state, so pipes
+     * enabled or given capacity later never need the pruned ones.
+     *
+     * Time Complexity: O(V + E)
+     *
+     * @param graph Pointer to the graph.
+     * @param source Pointer to the super source vertex.
+     * @param sink Pointer to the super sink vertex.
+     */
+    void build(Graph* graph, Vertex* source, Vertex* sink);
+
+    /**
+     * @brief Builds a network without flow from pipes, for networks derived from another one.
+     *
+     * The arcs have no Edge and no vertex has a Vertex, so the flow can't be written to a graph.
+     *
+     * Time Complexity: O(V + E)
+     *
+     * @param n The number of vertexes.
+     * @param source Index of the super source.
+     * @param sink Index of the super sink.
+     * @param pipes The pipes.
+     * @param pipeArcs Set to the arc of each pipe, from its tail to its head.
+     */
+    void build(int n, int source, int sink, const vector<Pipe>& pipes, vector<int>& pipeArcs);
+
+    /**
+     * @brief Removes every vertex and arc from the network.
+     *
+     * Time Complexity: O(1)
+     */
+    void clear();
+
+    /**
+     * @brief Checks if the network was built.
+     *
+     * Time Complexity: O(1)
+     *
+     * @return True if the network has vertexes, false otherwise.
+     */
+    bool isBuilt() const;
+
+    /**
+     * @brief Writes the flow of every arc back to the graph.
+     *
+     * The flow of each Edge becomes its residual capacity and the residual edges needed by the graph algorithms
+     * are created for pipes that carry flow. Pipes without arcs get no flow.
+     *
+     * Time Complexity: O(V + E)
+     */
+    void writeFlows() const;
+
+    /**
+     * @brief Sets the capacity of an arc, cancelling the flow that no longer fits.
+     *
+     * When the arc carries more flow than the new capacity, the extra flow is removed from the arc and then
+     * returned along the flow paths that reach its origin (back to the source) and its destination (up to the
+     * sink), so the result is still a valid flow. Every arc whose residual capacity changed is recorded and can be
+     * retrieved with takeChangedArcs().
+     *
+     * Time Complexity: O(V + E) in the worst case, O(1) when no flow has to be cancelled.
+     *
+     * @param arc Index of the arc.
+     * @param capacity The new capacity of the arc.
+     */
+    void setCapacity(int arc, long long capacity);
+
+    /**
+     * @brief Sets the original capacity of an arc, applying it if the arc is enabled.
+     *
+     * Time Complexity: Same as setCapacity.
+     *
+     * @param arc Index of the arc.
+     * @param capacity The new original capacity of the arc.
+     */
+    void setBaseCapacity(int arc, long long capacity);
+
+    /**
+     * @brief Removes flow that arrives at a vertex, walking back along the flow to the source.
+     *
+     * Used to turn a preflow into a flow, or to cancel flow that no longer fits in an arc.
+     *
+     * Time Complexity: O(V + E) in the worst case.
+     *
+     * @param v Index of the vertex with the excess.
+     * @param amount Amount of flow to remove.
+     */
+    void returnExcess(int v, long long amount);
+
+    /**
+     * @brief Updates the capacities of every arc of a vertex from the enabled state in the graph.
+     *
+     * Time Complexity: O(d * (V + E)) in the worst case, where d is the degree of the vertex.
+     *
+     * @param v Pointer to the vertex.
+     */
+    void refreshVertex(Vertex* v);
+
+    /**
+     * @brief Updates the capacities of the arcs of a pipe from the enabled state in the graph.
+     *
+     * Time Complexity: O(V + E) in the worst case.
+     *
+     * @param e Pointer to the edge.
+     */
+    void refreshEdge(const Edge* e);
+
+    /**
+     * @brief Returns and clears the arcs whose residual capacity changed since the last call.
+     *
+     * Time Complexity: O(1)
+     *
+     * @return Vector with the indexes of the changed arcs, possibly repeated.
+     */
+    vector<int> takeChangedArcs();
+
+    /**
+     * @brief Gets the value of the current flow, the net flow leaving the source.
+     *
+     * Time Complexity: O(d), where d is the degree of the source.
+     *
+     * @return The value of the flow.
+     */
+    long long getFlowValue() const;
+
+    /**
+     * @brief Removes the flow of every arc, leaving its residual capacity equal to its capacity.
+     *
+     * Time Complexity: O(E)
+     */
+    void clearFlow();
+
+    /**
+     * @brief Finds the vertexes the source reaches through arcs with residual capacity.
+     *
+     * After a maximum flow they are the source side of a minimum cut: every arc from them to the other vertexes is
+     * saturated.
+     *
+     * Time Complexity: O(V + E)
+     *
+     * @return 1 for each vertex the source reaches, 0 for the others.
+     */
+    vector<unsigned char> getSourceSide() const;
+
+    /**
+     * @brief Finds the vertexes that reach the sink through arcs with residual capacity.
+     *
+     * After a maximum flow, an arc from a vertex the source reaches to a vertex that reaches the sink is in every
+     * minimum cut, so it is the only kind of arc whose capacity increase alone increases the maximum flow.
+     *
+     * Time Complexity: O(V + E)
+     *
+     * @return 1 for each vertex that reaches the sink, 0 for the others.
+     */
+    vector<unsigned char> getSinkSide() const;
+
+    /**
+     * @brief Gets the index of a vertex in the network.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param v Pointer to the vertex.
+     * @return The index of the vertex, or -1 if it is not in the network.
+     */
+    int getIndex(const Vertex* v) const;
+
+    /**
+     * @brief Gets the index of the arc created from an edge.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param e Pointer to the edge.
+     * @return The index of the arc, or -1 if the edge is not in the network.
+     */
+    int getArc(const Edge* e) const;
+
+    /**
+     * @brief Gets the vertex with an index.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param index Index of the vertex.
+     * @return Pointer to the vertex.
+     */
+    Vertex* getVertex(int index) const { return vertices[index]; }
+
+    /**
+     * @brief Gets the edge an arc was created from.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param arc Index of the arc.
+     * @return Pointer to the edge, or nullptr for the reverse arc of a one-way pipe.
+     */
+    Edge* getEdge(int arc) const { return edges[arc]; }
+
+    int getNumberOfVertexes() const { return n; } /**< @brief Gets the number of vertexes. */
+    int getNumberOfArcs() const { return static_cast<int>(head.size()); } /**< @brief Gets the number of arcs. */
+    int getSource() const { return source; } /**< @brief Gets the index of the super source. */
+    int getSink() const { return sink; } /**< @brief Gets the index of the super sink. */
+    int getFirstArc(int v) const { return first[v]; } /**< @brief Gets the first arc leaving a vertex. */
+    int getEndArc(int v) const { return first[v + 1]; } /**< @brief Gets the arc after the last arc leaving a vertex. */
+    int getHead(int arc) const { return head[arc]; } /**< @brief Gets the destination of an arc. */
+    int getTail(int arc) const { return head[rev[arc]]; } /**< @brief Gets the origin of an arc. */
+    int getReverse(int arc) const { return rev[arc]; } /**< @brief Gets the reverse of an arc. */
+    long long getCapacity(int arc) const { return capacity[arc]; } /**< @brief Gets the current capacity of an arc. */
+    long long getBaseCapacity(int arc) const { return baseCapacity[arc]; } /**< @brief Gets the original capacity of an arc. */
+    long long getResidual(int arc) const { return residual[arc]; } /**< @brief Gets the residual capacity of an arc. */
+    long long getFlow(int arc) const { return capacity[arc] - residual[arc]; } /**< @brief Gets the net flow of an arc. */
+
+    /**
+     * @brief Sends flow along an arc, updating it and its reverse.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param arc Index of the arc.
+     * @param amount Amount of flow to send.
+     */
+    void push(int arc, long long amount) {
+        residual[arc] -= amount;
+        residual[rev[arc]] += amount;
+    }
+
+private:
+    /**
+     * @brief Checks if an arc should have its original capacity, using the enabled state in the graph.
+     * @param arc Index of the arc.
+     * @return True if the arc, its origin and its destination are enabled.
+     */
+    bool isArcEnabled(int arc) const;
+
+    /**
+     * @brief Finds the vertexes on a route from the source to the sink, with Tarjan's strongly connected components.
+     * @param firstOut First arc of each vertex in out, with a sentinel at the end.
+     * @param out Destination of each pipe direction, grouped by origin.
+     * @return 1 for each vertex the source reaches that reaches the sink, 0 for the others.
+     */
+    vector<unsigned char> findRelevantVertexes(const vector<int>& firstOut, const vector<int>& out) const;
+
+
+    /**
+     * @brief Removes flow that leaves a vertex, walking along the flow to the sink.
+     * @param v Index of the vertex with the deficit.
+     * @param amount Amount of flow to remove.
+     */
+    void returnDeficit(int v, long long amount);
+
+    Graph* graph = nullptr; /**< Pointer to the graph the network was built from. */
+    int n = 0; /**< The number of vertexes. */
+    int source = -1; /**< Index of the super source. */
+    int sink = -1; /**< Index of the super sink. */
+    vector<Vertex*> vertices; /**< Vertex of each index. */
+    unordered_map<const Vertex*, int> vertexIndex; /**< Index of each vertex. */
+    unordered_map<const Edge*, int> edgeArc; /**< Arc of each edge. */
+    vector<int> first; /**< First arc of each vertex, with a sentinel at the end. */
+    vector<int> head; /**< Destination of each arc. */
+    vector<int> rev; /**< Reverse of each arc. */
+    vector<long long> capacity; /**< Current capacity of each arc, 0 when disabled. */
+    vector<long long> baseCapacity; /**< Original capacity of each arc. */
+    vector<long long> residual; /**< Residual capacity of each arc. */
+    vector<Edge*> edges; /**< Edge of each arc, nullptr for reverse arcs of one-way pipes. */
+    vector<Edge*> prunedEdges; /**< Edges of the pipes without arcs. */
+    vector<int> changedArcs; /**< Arcs whose residual capacity changed outside of push. */
+};
+
+
+#endif //PROJECTDA_FLOWNETWORK_H
@@ -0,0 +1,41 @@
+#ifndef PROJECTDA_IMPORTDELTA_H
+#define PROJECTDA_IMPORTDELTA_H
+
+/**
+* @file ImportDelta.h
+* @brief This file contains the ImportDelta header.
+ */
+
+/**
+ * @struct ImportDelta
+ * @brief Differences between the data set files and the network already loaded.
+ *
+ * Changes to the demand of a city, the max delivery of a reservoir or the capacity of a pipe are applied to the
+ * loaded network. Any other change is structural and the network is imported again.
+ */
+struct ImportDelta {
+    int addedVertexes = 0; /**< Cities, reservoirs and stations only in the files. */
+    int removedVertexes = 0; /**< Cities, reservoirs and stations only in the network. */
+    int changedVertexes = 0; /**< Cities and reservoirs whose demand or max delivery changed. */
+    int replacedVertexes = 0; /**< Cities, reservoirs and stations with other changed attributes. */
+    int addedPipes = 0; /**< Pipes only in the files, or whose direction changed. */
+    int removedPipes = 0; /**< Pipes only in the network. */
+    int changedPipes = 0; /**< Pipes whose capacity changed. */
+    bool rebuilt = false; /**< Whether the network was imported again. */
+
+    /**
+     * @brief Checks if the network had to be imported again.
+     * @return True if there are structural changes, false otherwise.
+     */
+    bool isStructural() const {
+        return addedVertexes != 0 || removedVertexes != 0 || replacedVertexes != 0 || addedPipes != 0 || removedPipes != 0;
+    }
+
+    /**
+     * @brief Checks if the files match the network.
+     * @return True if nothing changed, false otherwise.
+     */
+    bool isEmpty() const { return !isStructural() && changedVertexes == 0 && changedPipes == 0; }
+};
+
+#endif //PROJECTDA_IMPORTDELTA_H
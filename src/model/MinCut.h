@@ -0,0 +1,49 @@
+#ifndef PROJECTDA_MINCUT_H
+#define PROJECTDA_MINCUT_H
+
+/**
+* @file MinCut.h
+* @brief This file contains the MinCut header.
+ */
+
+using namespace std;
+// Standard Library Headers
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct MinCut
+ * @brief The saturated pipes that separate the reservoirs from the cities in a maximum flow.
+ *
+ * The max deliveries of the reservoirs that are the bottleneck are included as pipes. Every city that doesn't get
+ * enough water is behind the cut, and all the water that reaches the cities behind it crosses its pipes, so their
+ * total capacity is the most those cities can get without upgrading them. Each pipe lists the cities whose water
+ * crosses it.
+ */
+struct MinCut {
+    /**
+     * @struct Pipe
+     * @brief A pipe of the cut.
+     */
+    struct Pipe {
+        string origin; /**< Code of the origin, or of the reservoir for a max delivery. */
+        string destination; /**< Code of the destination, or "(max delivery)" for the max delivery of a reservoir. */
+        int capacity; /**< Capacity of the pipe, or the max delivery. */
+        vector<pair<string,int>> cities; /**< Code and deficit of each city whose water crosses the pipe. */
+    };
+
+    vector<Pipe> pipes; /**< Pipes of the cut. */
+
+    /**
+     * @brief Gets the total capacity of the pipes.
+     * @return The capacity of the cut.
+     */
+    long long getCapacity() const {
+        long long capacity = 0;
+        for (const auto& pipe : pipes) capacity += pipe.capacity;
+        return capacity;
+    }
+};
+
+#endif //PROJECTDA_MINCUT_H
@@ -0,0 +1,49 @@
+/**
+* @file PipeTable.cpp
+* @brief This file contains the implementation of PipeTable.
+ */
+
+// Project headers
+#include "PipeTable.h"
+// Standard Library Headers
+#include <algorithm>
+
+int PipeTable::add(Edge* pipe) {
+    pipes.push_back(pipe);
+    return static_cast<int>(pipes.size()) - 1;
+}
+
+void PipeTable::clear() {
+    pipes.clear();
+    arcs.clear();
+}
+
+void PipeTable::bind(const FlowNetwork& network) {
+    arcs.resize(pipes.size());
+    for (size_t i = 0; i < pipes.size(); i++) {
+        arcs[i] = network.getArc(pipes[i]);
+    }
+}
+
+FlowMetrics PipeTable::getMetrics() const {
+    // The flow of an edge is its residual capacity, an edge that carries flow the other way has none
+    const size_t n = pipes.size();
+    vector<long long> flows(n);
+    vector<long long> capacities(n);
+    for (size_t i = 0; i < n; i++) {
+        capacities[i] = pipes[i]->getCapacity();
+        flows[i] = max(0LL, capacities[i] - pipes[i]->getFlow());
+    }
+    return computeFlowMetrics(flows, capacities);
+}
+
+FlowMetrics PipeTable::getMetrics(const FlowNetwork& network) const {
+    const size_t n = pipes.size();
+    vector<long long> flows(n);
+    vector<long long> capacities(n);
+    for (size_t i = 0; i < n; i++) {
+        capacities[i] = pipes[i]->getCapacity();
+        flows[i] = arcs[i] < 0 ? 0 : max(0LL, network.getFlow(arcs[i]));
+    }
+    return computeFlowMetrics(flows, capacities);
+}
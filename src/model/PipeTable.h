@@ -0,0 +1,80 @@
+#ifndef PROJECTDA_PIPETABLE_H
+#define PROJECTDA_PIPETABLE_H
+
+/**
+* @file PipeTable.h
+* @brief This file contains the PipeTable header.
+ */
+
+using namespace std;
+// Project headers
+#include "FlowMetrics.h"
+#include "FlowNetwork.h"
+#include "Graph.h"
+// Standard Library Headers
+#include <vector>
+
+/**
+ * @class PipeTable
+ * @brief Gives every pipe a dense index, in import order, so the flow of every pipe can be read without searching the graph.
+ *
+ * A two-way pipe has one entry per direction. Only the pipes of the data set are in the table, never the edges of the
+ * super source and super sink or the residual edges added while solving, so the flows of a sweep scenario can be
+ * gathered into flat arrays with one pass over the table.
+ */
+class PipeTable {
+public:
+    /**
+     * @brief Adds a pipe at the end of the table.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param pipe Pointer to the edge of the pipe.
+     * @return The index of the pipe.
+     */
+    int add(Edge* pipe);
+
+    /**
+     * @brief Removes every pipe.
+     *
+     * Time Complexity: O(P), where P is the number of pipes.
+     */
+    void clear();
+
+    /**
+     * @brief Maps every pipe to its arc in a network, for getMetrics on that network.
+     *
+     * Time Complexity: O(P), where P is the number of pipes.
+     *
+     * @param network The network, built from the graph of the pipes.
+     */
+    void bind(const FlowNetwork& network);
+
+    /**
+     * @brief Computes the statistics of the flow of every pipe in the solved graph.
+     *
+     * Time Complexity: O(P), where P is the number of pipes.
+     *
+     * @return The statistics of the flow and of the difference between capacity and flow of the pipes.
+     */
+    FlowMetrics getMetrics() const;
+
+    /**
+     * @brief Computes the statistics of the flow of every pipe in a solved network.
+     *
+     * Time Complexity: O(P), where P is the number of pipes.
+     *
+     * @param network The network, bound with bind since it was last built. The pipes it pruned carry no flow.
+     * @return The statistics of the flow and of the difference between capacity and flow of the pipes.
+     */
+    FlowMetrics getMetrics(const FlowNetwork& network) const;
+
+    int getNumberOfPipes() const { return static_cast<int>(pipes.size()); } /**< @brief Gets the number of pipes. */
+    Edge* getPipe(int pipe) const { return pipes[pipe]; } /**< @brief Gets the edge of the pipe with an index. */
+
+private:
+    vector<Edge*> pipes; /**< Edge of each pipe. */
+    vector<int> arcs; /**< Arc of each pipe in the bound network, or -1. */
+};
+
+#endif //PROJECTDA_PIPETABLE_H
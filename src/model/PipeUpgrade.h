@@ -0,0 +1,31 @@
+#ifndef PROJECTDA_PIPEUPGRADE_H
+#define PROJECTDA_PIPEUPGRADE_H
+
+/**
+* @file PipeUpgrade.h
+* @brief This file contains the PipeUpgrade header.
+ */
+
+using namespace std;
+// Standard Library Headers
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct PipeUpgrade
+ * @brief The water a pipe upgrade adds to the cities.
+ *
+ * The gain is the increase of the maximum flow when only this pipe is upgraded, so the gains of different upgrades
+ * don't add up: once one is done the cut may move and the others may add less.
+ */
+struct PipeUpgrade {
+    string origin; /**< Code of the origin, in the direction of the cut. */
+    string destination; /**< Code of the destination. */
+    int capacity; /**< Capacity of the pipe before the upgrade. */
+    long long delta; /**< Capacity added to the pipe. */
+    long long gain; /**< Water added to the cities. */
+    vector<pair<string,long long>> cities; /**< Code of each city that gets more water and how much more. */
+};
+
+#endif //PROJECTDA_PIPEUPGRADE_H
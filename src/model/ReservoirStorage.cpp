@@ -0,0 +1,33 @@
+/**
+* @file ReservoirStorage.cpp
+* @brief This file contains the implementation of ReservoirStorage.
+ */
+
+// Project headers
+#include "ReservoirStorage.h"
+// Standard Library Headers
+#include <algorithm>
+
+int ReservoirStorage::add(Reservoir* reservoir, const long long volume, const long long capacity) {
+    const int i = getNumberOfReservoirs();
+    reservoirs.push_back(reservoir);
+    codes.push_back(reservoir->getCode());
+    initialVolumes.push_back(volume);
+    volumes.push_back(volume);
+    capacities.push_back(capacity);
+    index[codes.back()] = i;
+    return i;
+}
+
+int ReservoirStorage::getIndex(const string& code) const {
+    const auto it = index.find(code);
+    return it == index.end() ? -1 : it->second;
+}
+
+long long ReservoirStorage::getAvailable(const int reservoir, const long long inflow) const {
+    return min(static_cast<long long>(reservoirs[reservoir]->getMaxDelivery()), max(0LL, volumes[reservoir] + inflow));
+}
+
+void ReservoirStorage::update(const int reservoir, const long long inflow, const long long delivered) {
+    volumes[reservoir] = min(capacities[reservoir], max(0LL, volumes[reservoir] + inflow - delivered));
+}
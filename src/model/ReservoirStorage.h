@@ -0,0 +1,96 @@
+#ifndef PROJECTDA_RESERVOIRSTORAGE_H
+#define PROJECTDA_RESERVOIRSTORAGE_H
+
+/**
+* @file ReservoirStorage.h
+* @brief This file contains the ReservoirStorage header.
+ */
+
+using namespace std;
+// Project headers
+#include "Graph.h"
+// Standard Library Headers
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class ReservoirStorage
+ * @brief Keeps the volume stored in some reservoirs while their deliveries are simulated over time.
+ *
+ * Every reservoir gets a dense index, in the order it was added, and its initial volume, current volume and capacity
+ * are kept in arrays aligned by that index. Volumes are measured in the units of flow delivered in one time step.
+ *
+ * In each step a reservoir can deliver what it stores plus its inflow, up to its max delivery. What it doesn't
+ * deliver stays stored, and what doesn't fit in its capacity spills. A negative inflow, like evaporation, takes volume
+ * away until the reservoir is empty.
+ */
+class ReservoirStorage {
+public:
+    /**
+     * @brief Adds a reservoir at the end of the table.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param reservoir Pointer to the reservoir.
+     * @param volume The initial volume.
+     * @param capacity The volume the reservoir can hold.
+     * @return The index of the reservoir.
+     */
+    int add(Reservoir* reservoir, long long volume, long long capacity);
+
+    /**
+     * @brief Gets the index of a reservoir.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param code The code of the reservoir.
+     * @return The index, or -1 if the reservoir is not in the table.
+     */
+    int getIndex(const string& code) const;
+
+    /**
+     * @brief Gets how much a reservoir can deliver in a step.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param reservoir Index of the reservoir.
+     * @param inflow The inflow of the reservoir in the step.
+     * @return The volume stored plus the inflow, up to the max delivery of the reservoir.
+     */
+    long long getAvailable(int reservoir, long long inflow) const;
+
+    /**
+     * @brief Updates the volume of a reservoir at the end of a step.
+     *
+     * Time Complexity: O(1)
+     *
+     * @param reservoir Index of the reservoir.
+     * @param inflow The inflow of the reservoir in the step.
+     * @param delivered The flow the reservoir delivered in the step.
+     */
+    void update(int reservoir, long long inflow, long long delivered);
+
+    /**
+     * @brief Sets the volume of every reservoir back to its initial volume.
+     *
+     * Time Complexity: O(R), where R is the number of reservoirs.
+     */
+    void restore() { volumes = initialVolumes; }
+
+    int getNumberOfReservoirs() const { return static_cast<int>(reservoirs.size()); } /**< @brief Gets the number of reservoirs. */
+    Reservoir* getReservoir(int reservoir) const { return reservoirs[reservoir]; } /**< @brief Gets the reservoir with an index. */
+    const string& getCode(int reservoir) const { return codes[reservoir]; } /**< @brief Gets the code of a reservoir. */
+    long long getVolume(int reservoir) const { return volumes[reservoir]; } /**< @brief Gets the current volume of a reservoir. */
+    long long getCapacity(int reservoir) const { return capacities[reservoir]; } /**< @brief Gets the capacity of a reservoir. */
+
+private:
+    vector<Reservoir*> reservoirs; /**< Reservoir with each index. */
+    vector<string> codes; /**< Code of each reservoir. */
+    vector<long long> initialVolumes; /**< Initial volume of each reservoir. */
+    vector<long long> volumes; /**< Current volume of each reservoir. */
+    vector<long long> capacities; /**< Capacity of each reservoir. */
+    unordered_map<string, int> index; /**< Index of the reservoir with each code. */
+};
+
+#endif //PROJECTDA_RESERVOIRSTORAGE_H
@@ -0,0 +1,48 @@
+#ifndef PROJECTDA_SOLVERCOUNTERS_H
+#define PROJECTDA_SOLVERCOUNTERS_H
+
+/**
+* @file SolverCounters.h
+* @brief This file contains the SolverCounters header.
+ */
+
+/**
+ * @brief Runs a statement that updates the solver counters, only in builds with WATERSUPPLY_INSTRUMENTATION.
+ *
+ * Without it the statement is not compiled, so the hot paths pay nothing for the counters.
+ */
+#ifdef WATERSUPPLY_INSTRUMENTATION
+#define SOLVER_COUNT(statement) statement
+#else
+#define SOLVER_COUNT(statement)
+#endif
+
+/**
+ * @struct SolverCounters
+ * @brief The work done by the path-based max-flow solvers, counted since the counters were last cleared.
+ */
+struct SolverCounters {
+    long long searches = 0; /**< Searches for an augmenting path, including the last one, which finds none. */
+    long long augmentingPaths = 0; /**< Augmenting paths found. */
+    long long verticesScanned = 0; /**< Vertexes whose edges were explored by the searches. */
+    long long edgesScanned = 0; /**< Edges examined by the searches. */
+    long long pathEdges = 0; /**< Total length of the augmenting paths, in edges. */
+    long long longestPath = 0; /**< Length of the longest augmenting path, in edges. */
+    long long residualEdges = 0; /**< Residual edges added to the graph while augmenting. */
+    long long resets = 0; /**< Resets of the graph. */
+    long long resetNanoseconds = 0; /**< Time spent resetting the graph. */
+
+    /**
+     * @brief Checks if the counters are updated in this build.
+     * @return True if the program was built with WATERSUPPLY_INSTRUMENTATION.
+     */
+    static constexpr bool isEnabled() {
+#ifdef WATERSUPPLY_INSTRUMENTATION
+        return true;
+#else
+        return false;
+#endif
+    }
+};
+
+#endif //PROJECTDA_SOLVERCOUNTERS_H
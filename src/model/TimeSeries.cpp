@@ -0,0 +1,14 @@
+/**
+* @file TimeSeries.cpp
+* @brief This file contains the implementation of TimeSeries.
+ */
+
+// Project headers
+#include "TimeSeries.h"
+
+TimeSeries::TimeSeries(vector<int> columns) : columns(std::move(columns)) {}
+
+void TimeSeries::addStep(const string& label, const vector<int>& values) {
+    labels.push_back(label);
+    this->values.insert(this->values.end(), values.begin(), values.end());
+}
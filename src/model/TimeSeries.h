@@ -0,0 +1,60 @@
+#ifndef PROJECTDA_TIMESERIES_H
+#define PROJECTDA_TIMESERIES_H
+
+/**
+* @file TimeSeries.h
+* @brief This file contains the TimeSeries header.
+ */
+
+using namespace std;
+// Standard Library Headers
+#include <string>
+#include <vector>
+
+/**
+ * @class TimeSeries
+ * @brief Represents a value of some vertexes, like the demand of cities or the inflow of reservoirs, over a sequence
+ * of time steps.
+ *
+ * Each column is a vertex, identified by its index in the table the series was read for, and each step is a row with
+ * the value of every column. The rows are stored one after the other in a single array.
+ */
+class TimeSeries {
+public:
+    /**
+     * @brief Creates an empty series, without columns or steps.
+     */
+    TimeSeries() = default;
+
+    /**
+     * @brief Creates a series without steps.
+     *
+     * Time Complexity: O(K), where K is the number of columns.
+     *
+     * @param columns The index of the vertex of each column.
+     */
+    explicit TimeSeries(vector<int> columns);
+
+    /**
+     * @brief Adds a step after the last one.
+     *
+     * Time Complexity: O(K), where K is the number of columns.
+     *
+     * @param label The label of the step.
+     * @param values The value of each column.
+     */
+    void addStep(const string& label, const vector<int>& values);
+
+    int getNumberOfSteps() const { return static_cast<int>(labels.size()); } /**< @brief Gets the number of steps. */
+    int getNumberOfColumns() const { return static_cast<int>(columns.size()); } /**< @brief Gets the number of columns. */
+    int getColumn(int column) const { return columns[column]; } /**< @brief Gets the index of the vertex of a column. */
+    const string& getLabel(int step) const { return labels[step]; } /**< @brief Gets the label of a step. */
+    int getValue(int step, int column) const { return values[step * columns.size() + column]; } /**< @brief Gets the value of a column in a step. */
+
+private:
+    vector<int> columns; /**< Index of the vertex of each column. */
+    vector<string> labels; /**< Label of each step. */
+    vector<int> values; /**< Value of each column in each step, one step after the other. */
+};
+
+#endif //PROJECTDA_TIMESERIES_H
@@ -145,6 +145,10 @@ int City::getDemand() const {
     return this->demand;
 }
 
+void City::setDemand(const int demand) {
+    this->demand = demand;
+}
+
 int City::getPopulation() const {
     return this->population;
 }
@@ -180,3 +184,7 @@ int Reservoir::getId() const{
 int Reservoir::getMaxDelivery() const{
     return this->maxDelivery;
 }
+
+void Reservoir::setMaxDelivery(const int maxDelivery) {
+    this->maxDelivery = maxDelivery;
+}
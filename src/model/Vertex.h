@@ -292,6 +292,15 @@ public:
      */
     int getDemand() const;
 
+    /**
+     * @brief Sets the demand of the city.
+     *
+     * Time Complexity - O(1)
+     *
+     * @param demand The new demand of the city.
+     */
+    void setDemand(int demand);
+
     /**
      * @brief Gets the population of the city.
      *
@@ -437,6 +446,15 @@ public:
     */
     int getMaxDelivery() const;
 
+    /**
+    * @brief Sets the max delivery of the resevoir.
+    *
+    * Time Complexity - O(1)
+    *
+    * @param maxDelivery The new max delivery of the reservoir.
+    */
+    void setMaxDelivery(int maxDelivery);
+
     /**
     * @brief Gets the ID of the resevoir.
     *
@@ -0,0 +1,264 @@
+/**
+* @file batch.cpp
+* @brief This file contains the Batch implementation.
+*/
+// Project headers
+#include "batch.h"
+#include "../controller/filewatcher.h"
+// Standard Library Headers
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+Batch::Batch(Manager* manager) {
+    this->manager = manager;
+}
+
+bool Batch::importDataset(const string& dataset) {
+    if (dataset == "small") {
+        datasetPaths = {"../data/Project1DataSetSmall/Cities_Madeira.csv","../data/Project1DataSetSmall/Reservoirs_Madeira.csv","../data/Project1DataSetSmall/Stations_Madeira.csv","../data/Project1DataSetSmall/Pipes_Madeira.csv"};
+    }
+    else if (dataset == "large") {
+        datasetPaths = {"../data/Project1LargeDataSet/Cities.csv","../data/Project1LargeDataSet/Reservoir.csv","../data/Project1LargeDataSet/Stations.csv","../data/Project1LargeDataSet/Pipes.csv"};
+    }
+    else {
+        return false;
+    }
+    manager->importFiles(datasetPaths[0], datasetPaths[1], datasetPaths[2], datasetPaths[3]);
+    return true;
+}
+
+void Batch::printUsage() {
+    cerr << "Usage: watersupply [--trace <file>] [--verify] [--output-dir <directory>] [--output-prefix <prefix>] "
+            "[--output-extension <extension>] --batch <small|large> <command> [arguments...]" << endl;
+    cerr << "Commands:" << endl;
+    cerr << "  paths                 Reservoir to city paths of the maximum flow" << endl;
+    cerr << "  attribution [city]    Flow each city receives from each reservoir" << endl;
+    cerr << "  sweep <file> [metrics]" << endl;
+    cerr << "                        Rows of a sweep file written by the failure sweeps, or with metrics the" << endl;
+    cerr << "                        statistics of the flow of the pipes after each scenario" << endl;
+    cerr << "  cut                   Saturated pipes of the minimum cut and the cities behind each one" << endl;
+    cerr << "  critical              Stations and pipes whose removal alone cuts cities off from every reservoir" << endl;
+    cerr << "  growth                Largest factor of every demand that still meets them, and the binding cut" << endl;
+    cerr << "  upgrades [delta]      Pipes ranked by the water adding delta to their capacity gives the cities" << endl;
+    cerr << "                        (0, the default, to double each pipe)" << endl;
+    cerr << "  profile               Time and hardware counters of every max-flow engine and failure sweep" << endl;
+    cerr << "  counters [engine]     Work of a path-based solver as JSON, engine edmonds-karp (the default) or" << endl;
+    cerr << "                        ford-fulkerson, counted in builds with WATERSUPPLY_INSTRUMENTATION" << endl;
+    cerr << "  reimport <cities> <reservoirs> <stations> <pipes>" << endl;
+    cerr << "                        City flows before and after loading changed data set files" << endl;
+    cerr << "  demand <profile>      Deficits at every step of a demand profile" << endl;
+    cerr << "  storage <storage> <inflows>..." << endl;
+    cerr << "                        Reservoir volumes and deficits at every step of each inflow scenario" << endl;
+    cerr << "  watch [debounce] [updates]" << endl;
+    cerr << "                        Refreshes the city flows and deficits result files whenever the data set files" << endl;
+    cerr << "                        change, after debounce milliseconds without changes (200 by default), until" << endl;
+    cerr << "                        the given number of updates (0, the default, to never stop)" << endl;
+}
+
+int Batch::run(const string& dataset, const string& command, const vector<string>& arguments) {
+    const bool valid = (command == "paths" && arguments.empty()) || (command == "attribution" && arguments.size() <= 1) ||
+                       (command == "sweep" && (arguments.size() == 1 || (arguments.size() == 2 && arguments[1] == "metrics"))) || (command == "growth" && arguments.empty()) ||
+                       (command == "cut" && arguments.empty()) || (command == "critical" && arguments.empty()) || (command == "upgrades" && arguments.size() <= 1) ||
+                       (command == "counters" && arguments.size() <= 1) || (command == "profile" && arguments.empty()) ||
+                       (command == "reimport" && arguments.size() == 4) ||
+                       (command == "demand" && arguments.size() == 1) || (command == "storage" && arguments.size() >= 2) ||
+                       (command == "watch" && arguments.size() <= 2);
+    if (!valid) {
+        cerr << "Error: Invalid command " << command << "." << endl;
+        printUsage();
+        return EXIT_FAILURE;
+    }
+    if (!importDataset(dataset)) {
+        cerr << "Error: Unknown data set " << dataset << "." << endl;
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    bool success = true;
+    if (command == "paths") {
+        paths();
+    }
+    else if (command == "attribution") {
+        success = attribution(arguments.empty() ? "" : arguments[0]);
+    }
+    else if (command == "sweep") {
+        sweep(arguments[0], arguments.size() == 2);
+    }
+    else if (command == "cut") {
+        manager->maxFlowBaseline();
+        Manager::writeMinCut(cout, manager->getMinCut());
+        manager->resetGraph();
+    }
+    else if (command == "critical") {
+        Manager::writeCriticality(cout, manager->getCriticality());
+    }
+    else if (command == "growth") {
+        Manager::writeDemandGrowth(cout, manager->getDemandGrowth());
+    }
+    else if (command == "upgrades") {
+        int delta = 0;
+        success = arguments.empty() || parseCount(arguments[0], delta);
+        if (success) Manager::writePipeUpgrades(cout, manager->planPipeUpgrades(delta));
+    }
+    else if (command == "counters") {
+        success = counters(arguments.empty() ? "edmonds-karp" : arguments[0]);
+    }
+    else if (command == "profile") {
+        manager->profileSolvers(cout);
+    }
+    else if (command == "reimport") {
+        reimport(arguments);
+    }
+    else if (command == "demand") {
+        demand(arguments[0]);
+    }
+    else if (command == "storage") {
+        storage(arguments);
+    }
+    else if (command == "watch") {
+        int debounce = 200, updates = 0;
+        success = (arguments.empty() || parseCount(arguments[0], debounce)) &&
+                  (arguments.size() < 2 || parseCount(arguments[1], updates)) && watch(debounce, updates);
+    }
+    cout.flush();
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void Batch::paths() {
+    Manager::writeFlowPaths(cout, manager->getFlowPathsEdmondsKarp());
+}
+
+bool Batch::attribution(const string& city) {
+    const Vertex* v = nullptr;
+    if (!city.empty()) {
+        const auto cities = manager->getCities();
+        const auto it = cities.find(city);
+        if (it == cities.end()) {
+            cerr << "Error: Unknown city " << city << "." << endl;
+            return false;
+        }
+        v = it->second;
+    }
+    const AttributionMatrix matrix = manager->getAttributionEdmondsKarp();
+    Manager::writeAttribution(cout, matrix, v == nullptr ? -1 : matrix.getCityIndex(v));
+    return true;
+}
+
+void Batch::sweep(const string& path, const bool metrics) {
+    const SweepReader reader(path);
+    if (metrics) {
+        cout << "Scenario,Pipes,TotalFlow,MinFlow,MaxFlow,MeanFlow,VarianceFlow,MedianFlow,P90Flow,P99Flow,"
+                "MinSlack,MaxSlack,MeanSlack,VarianceSlack,MedianSlack,P90Slack,P99Slack" << '\n';
+        for (const SweepReader::MetricsBlock& block : reader.getMetricsBlocks()) {
+            for (size_t i = 0; i < block.rows; i++) {
+                const FlowMetrics& m = block.metrics[i];
+                cout << reader.getCode(block.scenario[i]) << "," << m.count << "," << m.totalFlow << "," << m.minFlow << ","
+                     << m.maxFlow << "," << m.meanFlow << "," << m.varianceFlow << "," << m.medianFlow << "," << m.p90Flow
+                     << "," << m.p99Flow << "," << m.minSlack << "," << m.maxSlack << "," << m.meanSlack << ","
+                     << m.varianceSlack << "," << m.medianSlack << "," << m.p90Slack << "," << m.p99Slack << '\n';
+            }
+        }
+        return;
+    }
+    cout << "Scenario,City,Before,After,Decline" << '\n';
+    for (const SweepReader::Block& block : reader.getBlocks()) {
+        for (size_t i = 0; i < block.rows; i++) {
+            cout << reader.getCode(block.scenario[i]) << "," << reader.getCode(block.city[i]) << "," << block.before[i]
+                 << "," << block.after[i] << "," << block.decline[i] << "%" << '\n';
+        }
+    }
+}
+
+bool Batch::counters(const string& engine) {
+    if (engine != "edmonds-karp" && engine != "ford-fulkerson") {
+        cerr << "Error: Unknown engine " << engine << "." << endl;
+        return false;
+    }
+    const long long flow = manager->countMaxFlow(engine == "ford-fulkerson");
+    Manager::writeSolverCounters(cout, engine, flow, manager->getSolverCounters());
+    return true;
+}
+
+void Batch::reimport(const vector<string>& paths) {
+    const auto before = manager->maxFlowBaseline();
+    const ImportDelta delta = manager->reimportFiles(paths[0], paths[1], paths[2], paths[3]);
+    printDelta(delta);
+    const auto after = manager->maxFlowBaseline();
+
+    unordered_map<string,int> beforeFlows(before.begin(), before.end());
+    cout << "Code,Before,After" << '\n';
+    for (const auto& [code, flow] : after) {
+        const auto it = beforeFlows.find(code);
+        cout << code << "," << (it == beforeFlows.end() ? 0 : it->second) << "," << flow << '\n';
+    }
+    manager->resetGraph();
+}
+
+void Batch::demand(const string& path) {
+    manager->simulateDemandProfile(manager->importDemandProfile(path), cout);
+    manager->resetGraph();
+}
+
+void Batch::storage(const vector<string>& paths) {
+    ReservoirStorage storage = manager->importReservoirStorage(paths[0]);
+    manager->simulateStorage(storage, vector<string>(paths.begin() + 1, paths.end()), cout);
+    manager->resetGraph();
+}
+
+bool Batch::watch(int debounce, int updates) {
+    FileWatcher watcher(datasetPaths);
+    if (!watcher.isWatching()) {
+        cerr << "Error: Unable to watch the data set files." << endl;
+        return false;
+    }
+    ResultWriter& writer = manager->getResultWriter();
+    cout << "Update,Flow,Deficit,Milliseconds" << '\n';
+    for (int update = 0; updates == 0 || update <= updates; update++) {
+        if (update > 0) {
+            // A missing file is being replaced, the next change completes it
+            do {
+                if (!watcher.waitForChange(debounce)) {
+                    cerr << "Error: Unable to watch the data set files." << endl;
+                    return false;
+                }
+            } while (!canOpen(datasetPaths));
+        }
+        const auto start = chrono::steady_clock::now();
+        if (update > 0) printDelta(manager->reimportFiles(datasetPaths[0], datasetPaths[1], datasetPaths[2], datasetPaths[3]));
+        auto flows = manager->maxFlowBaseline();
+        const long long deficit = manager->writeBaselineResults(flows, "watch");
+        writer.flush();
+        const auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+
+        long long total = 0;
+        for (const auto& flow : flows) total += flow.second;
+        cout << update << "," << total << "," << deficit << "," << elapsed.count() << endl;
+    }
+    manager->resetGraph();
+    return true;
+}
+
+bool Batch::canOpen(const vector<string>& paths) {
+    for (const string& path : paths) {
+        if (!ifstream(path).is_open()) return false;
+    }
+    return true;
+}
+
+bool Batch::parseCount(const string& text, int& count) {
+    if (text.empty() || text.size() > 9 || text.find_first_not_of("0123456789") != string::npos) {
+        cerr << "Error: Invalid number " << text << "." << endl;
+        return false;
+    }
+    count = stoi(text);
+    return true;
+}
+
+void Batch::printDelta(const ImportDelta& delta) {
+    cerr << "Vertexes added: " << delta.addedVertexes << ", removed: " << delta.removedVertexes
+         << ", changed: " << delta.changedVertexes << ", replaced: " << delta.replacedVertexes << endl;
+    cerr << "Pipes added: " << delta.addedPipes << ", removed: " << delta.removedPipes << ", changed: " << delta.changedPipes << endl;
+    cerr << (delta.rebuilt ? "The network was imported again" : "The changes were applied to the loaded network") << endl;
+}
@@ -0,0 +1,151 @@
+#ifndef PROJECTDA_BATCH_H
+#define PROJECTDA_BATCH_H
+/**
+* @file batch.h
+* @brief This file contains the Batch header.
+*/
+
+// Project headers
+#include "../controller/manager.h"
+// Standard Library Headers
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class Batch
+ * @brief Runs one command on a data set without the menus, writing the result to the standard output in CSV format.
+ *
+ * Used as: watersupply --batch <small|large> <command> [arguments...]
+ */
+class Batch{
+    /**
+     * @brief Pointer to a manager instance.
+     */
+    Manager* manager;
+
+    /**
+     * @brief Paths of the cities, reservoirs, stations and pipes files of the imported data set.
+     */
+    vector<string> datasetPaths;
+
+    /**
+     * @brief Imports a data set.
+     * @param dataset Name of the data set, small or large.
+     * @return True if the data set exists, false otherwise.
+     */
+    bool importDataset(const string& dataset);
+
+    /**
+     * @brief Prints the usage of the batch mode to the standard error.
+     */
+    static void printUsage();
+
+    /**
+     * @brief Writes the weighted reservoir to city paths of the maximum flow, computed with Edmonds-Karp.
+     */
+    void paths();
+
+    /**
+     * @brief Writes the flow each city receives from each reservoir in the maximum flow, computed with Edmonds-Karp.
+     * @param city Code of the only city to write, or empty to write every city.
+     * @return True if the city exists, false otherwise.
+     */
+    bool attribution(const string& city);
+
+    /**
+     * @brief Writes the rows of a sweep file, with the codes of the scenarios and cities, or the statistics of the flow of the pipes after each scenario.
+     * @param path Path of the sweep file.
+     * @param metrics Whether to write the statistics instead of the rows.
+     */
+    static void sweep(const string& path, bool metrics);
+
+    /**
+     * @brief Computes the maximum flow with a path-based solver and writes the work it did as JSON.
+     *
+     * The counters are only updated in builds with WATERSUPPLY_INSTRUMENTATION, the JSON says whether they were.
+     *
+     * @param engine Name of the solver, edmonds-karp or ford-fulkerson.
+     * @return True if the engine exists, false otherwise.
+     */
+    bool counters(const string& engine);
+
+    /**
+     * @brief Loads changed data set files over the imported data set and writes the flow of each city before and after.
+     *
+     * The maximum flow is kept as a baseline and only repaired when the files just change demands, max deliveries
+     * or pipe capacities. A summary of the changes is written to the standard error.
+     *
+     * @param paths Paths of the cities, reservoirs, stations and pipes files.
+     */
+    void reimport(const vector<string>& paths);
+
+    /**
+     * @brief Writes the deficits at every step of a demand profile, each step repairing the flow of the previous one.
+     * @param path Path of the demand profile.
+     */
+    void demand(const string& path);
+
+    /**
+     * @brief Writes the reservoir volumes and the deficits at every step of inflow scenarios.
+     *
+     * The flow of each step is repaired from the flow of the previous one, across scenarios too.
+     *
+     * @param paths Path of the storage file, followed by the paths of the inflows of each scenario.
+     */
+    void storage(const vector<string>& paths);
+
+    /**
+     * @brief Refreshes the result files with the flow and deficit of every city whenever the data set files change.
+     *
+     * The maximum flow is kept as a baseline: after a burst of changes to the files, once they are quiet for the
+     * debounce interval, the changes are loaded with a delta import and the flow is repaired around them, then
+     * "watch_flows" and "watch_deficits" are replaced in the results directory. A row with the total flow, the total
+     * deficit and the time the refresh took is written for the initial flow and after each refresh.
+     *
+     * @param debounce The debounce interval, in milliseconds.
+     * @param updates The number of refreshes before returning, or 0 to never return.
+     * @return True if the files were watched, false otherwise.
+     */
+    bool watch(int debounce, int updates);
+
+    /**
+     * @brief Checks if files can be opened.
+     * @param paths The paths of the files.
+     * @return True if every file can be opened, false otherwise.
+     */
+    static bool canOpen(const vector<string>& paths);
+
+    /**
+     * @brief Parses a non-negative number given as an argument.
+     * @param text The argument.
+     * @param count Set to the number.
+     * @return True if the argument is a number, false otherwise.
+     */
+    static bool parseCount(const string& text, int& count);
+
+    /**
+     * @brief Writes a summary of the changes found by a delta import to the standard error.
+     * @param delta The changes.
+     */
+    static void printDelta(const ImportDelta& delta);
+
+public:
+    /**
+     * @brief Constructor for Batch.
+     * @param manager Pointer to a Manager instance.
+     */
+    explicit Batch(Manager* manager);
+
+    /**
+     * @brief Runs a command.
+     * @param dataset Name of the data set, small or large.
+     * @param command Name of the command.
+     * @param arguments Arguments of the command.
+     * @return EXIT_SUCCESS, or EXIT_FAILURE if the data set or the command are not valid.
+     */
+    int run(const string& dataset, const string& command, const vector<string>& arguments);
+};
+
+#endif //PROJECTDA_BATCH_H
@@ -25,12 +25,14 @@ string Menu::removeLeadingTrailingSpaces(const string& input) {
     return (start != string::npos && end != string::npos) ? input.substr(start, end - start + 1) : "";
 }
 /* Timer functions */
-void Menu::startTimer(timespec& start_real, timespec& start_cpu) const {
+void Menu::startTimer(timespec& start_real, timespec& start_cpu) {
     clock_gettime(CLOCK_REALTIME, &start_real);
     clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &start_cpu);
+    probe.start();
 }
 
-void Menu::stopTimer(timespec& start_real, timespec& start_cpu, double& elapsed_real, double& elapsed_cpu) const {
+void Menu::stopTimer(timespec& start_real, timespec& start_cpu, double& elapsed_real, double& elapsed_cpu) {
+    const PerfProbe::Sample sample = probe.stop();
     timespec end_real, end_cpu;
 
     clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &end_cpu);
@@ -44,6 +46,10 @@ void Menu::stopTimer(timespec& start_real, timespec& start_cpu, double& elapsed_
 
     cout << "Elapsed real time: " << elapsed_real << " seconds" << endl;
     cout << "Elapsed CPU time: " << elapsed_cpu << " seconds" << endl;
+    if (sample.cycles >= 0) cout << "Cycles: " << sample.cycles << endl;
+    if (sample.instructions >= 0) cout << "Instructions: " << sample.instructions << endl;
+    if (sample.cacheMisses >= 0) cout << "Cache misses: " << sample.cacheMisses << endl;
+    if (sample.branchMisses >= 0) cout << "Branch misses: " << sample.branchMisses << endl;
 }
 
 /* Valid input check for codes */
@@ -271,11 +277,12 @@ void Menu::mainMenu() {
         cout << "                                                " << endl;
         cout << "             1. Choose small data set           " << endl;
         cout << "             2. Choose large data set           " << endl;
-        cout << "             3. Exit menu                       " << endl;
+        cout << "             3. Result files                    " << endl;
+        cout << "             4. Exit menu                       " << endl;
         cout << "                                                " << endl;
         cout << "------------------------------------------------" << endl;
     }
-    while(!getNumberInput(1,3,&option));
+    while(!getNumberInput(1,4,&option));
 
     switch(option) {
         case 1:
@@ -289,6 +296,10 @@ void Menu::mainMenu() {
             algorithmMenu();
             break;
         case 3:
+            menuStack.push(&Menu::mainMenu);
+            resultFilesMenu();
+            break;
+        case 4:
             exitMenu();
             break;
     }
@@ -366,10 +377,12 @@ void Menu::exercise21() {
         cout << "             2. Edmonds Karp -> All cities      " << endl;
         cout << "             3. Ford Fulkerson -> One city      " << endl;
         cout << "             4. Ford Fulkerson -> All cities    " << endl;
+        cout << "             5. Push Relabel -> One city        " << endl;
+        cout << "             6. Push Relabel -> All cities      " << endl;
         cout << "                                                " << endl;
         cout << "------------------------------------------------" << endl;
     }
-    while(!getNumberInput(0,4,&option));
+    while(!getNumberInput(0,6,&option));
 
     vector<string> cities;
     timespec start_real;
@@ -419,6 +432,26 @@ void Menu::exercise21() {
             stopTimer(start_real,start_cpu,elapsed_real,elapsed_cpu);
             exercise21();
             break;
+
+        case 5:
+            cities = getCities();
+            if (cities.empty()) {
+                cout << "No cities were selected" << endl;
+            }
+            else {
+                startTimer(start_real,start_cpu);
+                manager->getPushRelabelXCity(cities);
+                stopTimer(start_real,start_cpu,elapsed_real,elapsed_cpu);
+            }
+            exercise21();
+            break;
+
+        case 6:
+            startTimer(start_real,start_cpu);
+            manager->getPushRelabelAllCities();
+            stopTimer(start_real,start_cpu,elapsed_real,elapsed_cpu);
+            exercise21();
+            break;
     }
 }
 
@@ -514,13 +547,13 @@ void Menu::exercise23(){
             break;
         case 1:
             manager->getEdmondsKarpAllCities(false);
-            manager->improvePipesHeuristic();
+            manager->improvePipesMinCost();
             stopTimer(start_real,start_cpu,elapsed_real,elapsed_cpu);
             exercise23();
             break;
         case 2:
             manager->getFordFulkersonAllCities(false);
-            manager->improvePipesHeuristic();
+            manager->improvePipesMinCost();
             stopTimer(start_real,start_cpu,elapsed_real,elapsed_cpu);
             exercise23();
             break;
@@ -602,10 +635,12 @@ void Menu::exercise32() {
         cout << "             2. Disable each station (FF)       " << endl;
         cout << "             3. Disable selected stations (EK)  " << endl;
         cout << "             4. Disable selected stations (FF)  " << endl;
+        cout << "             5. Disable each station (BK)       " << endl;
+        cout << "             6. Single points of failure        " << endl;
         cout << "                                                " << endl;
         cout << "------------------------------------------------" << endl;
     }
-    while(!getNumberInput(0,4,&option));
+    while(!getNumberInput(0,6,&option));
     string code;
     vector<string> stations;
     timespec start_real;
@@ -652,6 +687,18 @@ void Menu::exercise32() {
             }
             exercise32();
             break;
+        case 5:
+            startTimer(start_real,start_cpu);
+            manager->disableEachStationBoykovKolmogorov();
+            stopTimer(start_real,start_cpu,elapsed_real,elapsed_cpu);
+            exercise32();
+            break;
+        case 6:
+            startTimer(start_real,start_cpu);
+            manager->criticalElements();
+            stopTimer(start_real,start_cpu,elapsed_real,elapsed_cpu);
+            exercise32();
+            break;
 
     }
 }
@@ -667,10 +714,11 @@ void Menu::exercise33() {
         cout << "             2. Disable each pipe (FF)          " << endl;
         cout << "             3. Disable selected pipes (EK)     " << endl;
         cout << "             4. Disable selected pipes (FF)     " << endl;
+        cout << "             5. Disable each pipe (BK)          " << endl;
         cout << "                                                " << endl;
         cout << "------------------------------------------------" << endl;
     }
-    while(!getNumberInput(0,4,&option));
+    while(!getNumberInput(0,5,&option));
     string code;
     vector<Edge*> pipes;
     timespec start_real;
@@ -717,6 +765,12 @@ void Menu::exercise33() {
             }
             exercise33();
             break;
+        case 5:
+            startTimer(start_real,start_cpu);
+            manager->disableEachPipeBoykovKolmogorov();
+            stopTimer(start_real,start_cpu,elapsed_real,elapsed_cpu);
+            exercise33();
+            break;
     }
 }
 
@@ -731,10 +785,14 @@ void Menu::extraMenu() {
         cout << "             2. TopK cities with max-flow (FF)  " << endl;
         cout << "             3. Average Flow rate per city (EK) " << endl;
         cout << "             4. Average Flow rate per city (FF) " << endl;
+        cout << "             5. Flow paths to cities (EK)       " << endl;
+        cout << "             6. Flow paths to cities (FF)       " << endl;
+        cout << "             7. Reservoirs supplying cities (EK)" << endl;
+        cout << "             8. Reservoirs supplying cities (FF)" << endl;
         cout << "                                                " << endl;
         cout << "------------------------------------------------" << endl;
     }
-    while(!getNumberInput(0,4,&option));
+    while(!getNumberInput(0,8,&option));
     int k;
     bool validResult;
     int maxK;
@@ -782,11 +840,68 @@ void Menu::extraMenu() {
             stopTimer(start_real,start_cpu,elapsed_real,elapsed_cpu);
             extraMenu();
             break;
+        case 5:
+            startTimer(start_real,start_cpu);
+            manager->flowPathsEdmondsKarp();
+            stopTimer(start_real,start_cpu,elapsed_real,elapsed_cpu);
+            extraMenu();
+            break;
+        case 6:
+            startTimer(start_real,start_cpu);
+            manager->flowPathsFordFulkerson();
+            stopTimer(start_real,start_cpu,elapsed_real,elapsed_cpu);
+            extraMenu();
+            break;
+        case 7:
+            startTimer(start_real,start_cpu);
+            manager->attributionEdmondsKarp();
+            stopTimer(start_real,start_cpu,elapsed_real,elapsed_cpu);
+            extraMenu();
+            break;
+        case 8:
+            startTimer(start_real,start_cpu);
+            manager->attributionFordFulkerson();
+            stopTimer(start_real,start_cpu,elapsed_real,elapsed_cpu);
+            extraMenu();
+            break;
 
 
     }
 }
 
+void Menu::resultFilesMenu() {
+    ResultWriter& writer = manager->getResultWriter();
+    int option = 0;
+    do {
+        cout << "------------------------------------------------" << endl;
+        cout << "                Menu -> Result files            " << endl;
+        cout << "                                                " << endl;
+        cout << "             Files: " << writer.getPath("<name>") << endl;
+        cout << "                                                " << endl;
+        cout << "             0. Go back                         " << endl;
+        cout << "             1. Change directory                " << endl;
+        cout << "             2. Change prefix                   " << endl;
+        cout << "             3. Change extension                " << endl;
+        cout << "                                                " << endl;
+        cout << "------------------------------------------------" << endl;
+    }
+    while(!getNumberInput(0,3,&option));
+
+    if (option == 0) {
+        goBack();
+        return;
+    }
+    // An empty prefix is valid, the directory and the extension keep their value when left empty
+    string input;
+    cout << "Enter the new " << (option == 1 ? "directory" : option == 2 ? "prefix" : "extension") << ": ";
+    getline(cin, input);
+    input = removeLeadingTrailingSpaces(input);
+    if (option == 1 && !input.empty()) writer.setDirectory(input);
+    else if (option == 2) writer.setPrefix(input);
+    else if (option == 3 && !input.empty()) writer.setExtension(input);
+    resultFilesMenu();
+}
+
 void Menu::exitMenu() {
     while (!menuStack.empty()) {
         menuStack.pop();
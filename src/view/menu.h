@@ -28,6 +28,10 @@ class Menu{
      * @brief Pointer to a manager instance.
      */
     Manager* manager;
+    /**
+     * @brief Hardware counters of the timed actions.
+     */
+    PerfProbe probe;
 
     /* Auxiliary functions */
     /**
@@ -39,19 +43,19 @@ class Menu{
 
     /* Timer functions */
     /**
-    * @brief Starts a timer.
+    * @brief Starts a timer and the hardware counters.
     * @param start_real Reference to the start time in real time.
     * @param start_cpu Reference to the start time in CPU time.
     */
-    void startTimer(timespec& start_real, timespec& start_cpu) const;
+    void startTimer(timespec& start_real, timespec& start_cpu);
     /**
-    * @brief Stops a timer and calculates elapsed time.
+    * @brief Stops a timer and calculates elapsed time, printing it with the hardware counters that are available.
      * @param start_real Reference to the start time in real time.
      * @param start_cpu Reference to the start time in CPU time.
      * @param elapsed_real Reference to store the elapsed real time.
      * @param elapsed_cpu Reference to store the elapsed CPU time.
      */
-    void stopTimer(timespec& start_real, timespec& start_cpu, double& elapsed_real, double& elapsed_cpu) const;
+    void stopTimer(timespec& start_real, timespec& start_cpu, double& elapsed_real, double& elapsed_cpu);
 
     /* Validity of input */
     /**
@@ -229,6 +233,11 @@ public:
      */
         void extraMenu();
 
+    /**
+     * @brief Displays the menu to change the directory, prefix and extension of the result files.
+     */
+        void resultFilesMenu();
+
 };
 
 #endif //PROJECTDA_MENU_H